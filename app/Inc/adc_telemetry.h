@@ -0,0 +1,40 @@
+#ifndef INC_ADC_TELEMETRY_H_
+#define INC_ADC_TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************************************
+*                ADC STREAM OVER TELEMETRY                  *
+*************************************************************/
+
+/*
+ * TELEMETRY_TYPE_ADC payload (little endian):
+ *
+ *   first_index (u32) | t_us (u32) | overruns (u16) | count (u8) |
+ *   first sample (u16) | count-1 x varint(zigzag(delta))
+ *
+ * first_index counts samples delivered since start, t_us is the low
+ * word of timebase_us when the packet was built, overruns is the
+ * cumulative number of samples lost to a full FIFO (saturating).
+ *
+ * Rates are capped by the telemetry link: adc_telemetry_start() refuses
+ * a rate whose worst-case wire rate (two varint bytes per delta) would
+ * exceed telemetry_link_budget(). UART2 at 115200 tops out near 4.9 kHz.
+ * The presets above the cap are skipped.
+ */
+
+#define ADC_TELEMETRY_MAX_SAMPLES   64u
+#define ADC_TELEMETRY_DEFAULT_HZ    1000u
+
+bool     adc_telemetry_start(uint32_t rate_hz);
+void     adc_telemetry_stop(void);
+uint32_t adc_telemetry_rate(void);          /* Hz the next start uses, kept across stop */
+uint32_t adc_telemetry_next_rate(void);     /* cycles through the presets the link can carry */
+uint32_t adc_telemetry_max_rate(void);      /* Hz, from the current link budget */
+
+/* call periodically from the main loop */
+void     adc_telemetry_pump(void);
+void     adc_telemetry_report(void);
+
+#endif /* INC_ADC_TELEMETRY_H_ */
@@ -4,8 +4,6 @@
 #include "interface_defines.h"
 
 void config_app(void);
-void config_interface(void);
-void config_core(void);
 
 /************************************************************
 *              BOARD PIN MAPPING — STM32F411E               *
@@ -26,9 +24,17 @@ void config_core(void);
 /* ADC Channels */
 #define BOARD_ADC_CHANNEL0      INTERFACE_ADC_0     /* PA1 - ADC1 CH1 */
 
+/* Overcurrent fast trip on Output 1 (interface_trip.h) */
+#define BOARD_TRIP_ADC_THRESHOLD    3700u   /* ADC0 counts, ~3.0 V */
+#define BOARD_TRIP_COMPARATOR       1       /* PA0 as TIM2_ETR — the user button stands in */
+
 /* Communication */
 #define BOARD_COMM_SERIAL       INTERFACE_PROTOCOL_UART2
 #define BOARD_COMM_I2C          INTERFACE_PROTOCOL_I2C1
+#define BOARD_COMM_USB          INTERFACE_PROTOCOL_USB_CDC
+
+/* uprint + CLI; BOARD_COMM_USB moves the console to the USB port */
+#define BOARD_COMM_CONSOLE      BOARD_COMM_SERIAL
 
 /* BSP UUIDs — explicitamente definidos para evitar dependencia de ordem */
 #define BOARD_UUID_LED_ONBOARD  0
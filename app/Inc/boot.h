@@ -0,0 +1,32 @@
+#ifndef INC_BOOT_H_
+#define INC_BOOT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************************************
+*                    BOOT INIT GRAPH                        *
+*************************************************************/
+
+/*
+ * Each stage lists the stages it depends on as a bitmask of their index
+ * in the table. boot_run() executes every stage exactly once, after all
+ * of its dependencies, and timestamps it with the DWT cycle counter.
+ */
+
+#define BOOT_MAX_STAGES     32u
+#define BOOT_DEP(stage)     (1UL << (stage))
+
+typedef struct
+{
+    const char *name;
+    void      (*init)(void);
+    uint32_t    deps;
+} boot_stage_t;
+
+/* false if the table has a dependency cycle or an unknown dependency */
+bool     boot_run(const boot_stage_t *stages, uint8_t count);
+uint32_t boot_total_us(void);
+void     boot_report(void);
+
+#endif /* INC_BOOT_H_ */
@@ -0,0 +1,22 @@
+#ifndef INC_FAST_BENCH_H_
+#define INC_FAST_BENCH_H_
+
+/************************************************************
+*               FLASH vs SRAM EXECUTION                     *
+*************************************************************/
+
+/*
+ * One workload is compiled twice, once in flash and once as FAST_CODE in
+ * SRAM. It is a ring-buffer push/pop with a branchy consumer, the same
+ * shape as the placed hot paths. Each clock profile is timed in DWT
+ * cycles (best of several runs).
+ *
+ * The board runs on HSI at 16 MHz, so each profile is reproduced by its
+ * flash wait-state setting rather than a clock switch. A wait state
+ * costs the same number of core cycles at any frequency, so cycles per
+ * run match what the profile's clock would show. Columns: flash with
+ * the ART accelerator off, flash with ART on (warm), SRAM.
+ */
+void fast_bench_run(void);
+
+#endif /* INC_FAST_BENCH_H_ */
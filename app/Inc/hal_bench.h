@@ -0,0 +1,23 @@
+#ifndef INC_HAL_BENCH_H_
+#define INC_HAL_BENCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/************************************************************
+*            C DISPATCH vs C++ TEMPLATE HAL                 *
+*************************************************************/
+
+/*
+ * Cycle counts come from the DWT counter (best of several runs). Code
+ * size: every measured path is a noinline function in its own section,
+ * so flash.map lists .text.bench_c_* next to .text.bench_hal_*.
+ */
+void hal_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_HAL_BENCH_H_ */
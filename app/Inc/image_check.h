@@ -0,0 +1,33 @@
+#ifndef INC_IMAGE_CHECK_H_
+#define INC_IMAGE_CHECK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************************************
+*                 FLASH IMAGE INTEGRITY                     *
+*************************************************************/
+
+/*
+ * tools/image_crc.py seals flash.bin after every build: it pads the image
+ * to a whole word with 0xFF and appends its CRC-32 (interface_crc.h). The
+ * CRC over image + trailer is then 0. Flashing the ELF from a debugger
+ * leaves the trailer erased, which reads as "not sealed".
+ */
+typedef struct
+{
+    uint32_t base;
+    uint32_t length;        /* bytes covered, trailer excluded */
+    uint32_t stored;        /* trailer word */
+    uint32_t computed;      /* CRC over the image alone */
+    uint32_t cycles;
+    bool     sealed;
+    bool     ok;
+} image_check_t;
+
+void image_check_run(image_check_t *out);
+
+/* `crc` CLI command: verify the image, then bytes/cycle per CRC path */
+void image_check_report(void);
+
+#endif /* INC_IMAGE_CHECK_H_ */
@@ -0,0 +1,58 @@
+#ifndef INC_LOOPMON_H_
+#define INC_LOOPMON_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************************************
+*                 SUPER-LOOP MONITOR                        *
+*************************************************************/
+
+/*
+ * Usage in the main loop:
+ *
+ *   loopmon_begin();
+ *   ticker_update();  loopmon_mark(LOOP_COMP_TICKER);
+ *   cli_update();     loopmon_mark(LOOP_COMP_CLI);
+ *   fault_update();   loopmon_mark(LOOP_COMP_FAULT);
+ *   loopmon_end();
+ *
+ * Iteration times go into a log2 histogram: bucket 0 holds iterations
+ * shorter than 2 us, bucket n holds [2^n, 2^(n+1)) us, the last bucket
+ * everything longer.
+ *
+ * The per-mark path stores raw DWT cycle deltas. Only the histogram
+ * bucket needs microseconds, which costs one 32-bit hardware divide per
+ * iteration. Stats convert to us in loopmon_report()/loopmon_serialize().
+ */
+
+#define LOOPMON_BUCKETS         16u
+#define LOOPMON_MAX_COMPONENTS  8u
+
+typedef struct
+{
+    uint32_t iterations;
+    uint32_t deadline_misses;
+    uint32_t worst_cyc;
+    uint8_t  worst_component;                   /* slowest part of the worst iteration */
+    uint32_t component_worst_cyc[LOOPMON_MAX_COMPONENTS];
+    uint32_t histogram[LOOPMON_BUCKETS];
+} loopmon_stats_t;
+
+void loopmon_init(const char *const *component_names, uint8_t count, uint32_t deadline_us);
+
+/* feed the IWDG from loopmon_end() only when the iteration met the deadline */
+void loopmon_watchdog_enable(uint32_t timeout_ms);
+
+void loopmon_begin(void);
+void loopmon_mark(uint8_t component);
+void loopmon_end(void);
+
+const loopmon_stats_t *loopmon_stats(void);
+void     loopmon_reset(void);
+void     loopmon_report(void);
+
+/* packed little-endian snapshot for the binary telemetry stream */
+uint32_t loopmon_serialize(uint8_t *buf, uint32_t len);
+
+#endif /* INC_LOOPMON_H_ */
@@ -0,0 +1,53 @@
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/************************************************************
+*                 BINARY TELEMETRY FRAMES                   *
+*************************************************************/
+
+/*
+ * Frame layout (little endian):
+ *
+ *   0xA5 0x5A | type | seq | len (u16) | payload[len] | fletcher16 (u16)
+ *
+ * The checksum covers type..payload. seq increments per frame so the
+ * host can count lost frames. Text CLI output may be interleaved on the
+ * same link; the decoder resyncs on the sync bytes and checksum.
+ */
+
+#define TELEMETRY_SYNC0         0xA5u
+#define TELEMETRY_SYNC1         0x5Au
+#define TELEMETRY_HEADER_SIZE   6u
+#define TELEMETRY_TRAILER_SIZE  2u
+#define TELEMETRY_MAX_PAYLOAD   256u
+
+/* Sustained payload+framing bytes/s per link, for rate budgeting */
+#define TELEMETRY_UART2_BYTES_PER_SEC   (115200u / 10u)     /* 8N1, protocol_uart.c */
+#define TELEMETRY_USB_BYTES_PER_SEC     500000u             /* full-speed bulk, conservative */
+
+typedef enum
+{
+    TELEMETRY_TYPE_ADC  = 0x01,     /* adc_telemetry.h */
+    TELEMETRY_TYPE_LOOP = 0x02,     /* loopmon_serialize() */
+    TELEMETRY_TYPE_RECORD = 0x03,   /* record log chunk, interface_record.h */
+} telemetry_type_t;
+
+void     telemetry_init(uint8_t comm_id);
+bool     telemetry_send(uint8_t type, const uint8_t *payload, uint16_t len);
+uint32_t telemetry_frames_sent(void);
+uint32_t telemetry_link_budget(void);       /* bytes/s of the current comm, 0 = unknown */
+
+uint16_t telemetry_fletcher16(uint16_t state, const uint8_t *data, uint32_t len);
+
+/* unsigned LEB128; returns bytes written (max 5) */
+uint32_t telemetry_put_varint(uint8_t *out, uint32_t value);
+
+static inline uint32_t telemetry_zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+#endif /* INC_TELEMETRY_H_ */
@@ -0,0 +1,20 @@
+#ifndef INC_UPRINT_FAST_H_
+#define INC_UPRINT_FAST_H_
+
+/************************************************************
+*                 UPRINT ON THE FMT FORMATTER               *
+*************************************************************/
+
+/*
+ * The link wraps uprint()/uprint_setup() from the common library
+ * (-Wl,--wrap), so every caller, the CLI included, formats through
+ * fmt.h straight into comm_send() in FMT_CHUNK_SIZE pieces.
+ *
+ * With -DUPRINT_BENCH=ON the library's own uprint stays linked as the
+ * baseline for `printbench`. Both run against a comm id with no instance,
+ * so the numbers are formatting cost only. Flash footprint:
+ * tools/map_report.py flash.map --match 'fmt|vfprintf|uprint'.
+ */
+void uprint_bench_run(void);
+
+#endif /* INC_UPRINT_FAST_H_ */
@@ -0,0 +1,125 @@
+#include "adc_telemetry.h"
+#include "telemetry.h"
+#include "interface_adc_stream.h"
+#include "interface_timebase_us.h"
+#include "core/uprint.h"
+
+#define ADC_PAYLOAD_HEADER  13u
+#define ADC_PAYLOAD_MAX     (ADC_PAYLOAD_HEADER + 2u + (ADC_TELEMETRY_MAX_SAMPLES - 1u) * 3u)
+
+/* A full packet on the wire when every 12-bit delta takes two varint bytes (zigzag < 2^14) */
+#define ADC_WIRE_WORST      (TELEMETRY_HEADER_SIZE + ADC_PAYLOAD_HEADER + 2u + \
+                             (ADC_TELEMETRY_MAX_SAMPLES - 1u) * 2u + TELEMETRY_TRAILER_SIZE)
+
+static const uint32_t s_rates[] = { 100u, 500u, 1000u, 2000u, 5000u, 10000u };
+#define RATE_COUNT  (sizeof(s_rates) / sizeof(s_rates[0]))
+
+static uint32_t s_rate_hz  = ADC_TELEMETRY_DEFAULT_HZ;
+static uint32_t s_index    = 0u;
+static uint32_t s_raw_bytes = 0u;
+static uint32_t s_enc_bytes = 0u;
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t encode(uint8_t *out, const uint16_t *samples, uint32_t count)
+{
+    uint32_t overruns = adc_stream_overruns();
+
+    put_u32(&out[0], s_index);
+    put_u32(&out[4], timebase_us_get32());
+    put_u16(&out[8], (uint16_t)((overruns > 0xFFFFu) ? 0xFFFFu : overruns));
+    out[10] = (uint8_t)count;
+    put_u16(&out[11], samples[0]);
+
+    uint32_t n = ADC_PAYLOAD_HEADER;
+    for (uint32_t i = 1u; i < count; i++)
+    {
+        int32_t delta = (int32_t)samples[i] - (int32_t)samples[i - 1u];
+        n += telemetry_put_varint(&out[n], telemetry_zigzag(delta));
+    }
+    return n;
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+uint32_t adc_telemetry_max_rate(void)
+{
+    return (uint32_t)(((uint64_t)telemetry_link_budget() * ADC_TELEMETRY_MAX_SAMPLES) / ADC_WIRE_WORST);
+}
+
+bool adc_telemetry_start(uint32_t rate_hz)
+{
+    if (rate_hz > adc_telemetry_max_rate()) return false;     /* pump would block, FIFO overrun */
+    if (!adc_stream_start(rate_hz)) return false;
+
+    s_rate_hz   = rate_hz;
+    s_index     = 0u;
+    s_raw_bytes = 0u;
+    s_enc_bytes = 0u;
+    return true;
+}
+
+void adc_telemetry_stop(void)
+{
+    adc_stream_stop();
+}
+
+uint32_t adc_telemetry_rate(void)
+{
+    return s_rate_hz;
+}
+
+uint32_t adc_telemetry_next_rate(void)
+{
+    uint32_t i = 0u;
+    while (i < RATE_COUNT && s_rates[i] <= s_rate_hz) i++;
+    if (i == RATE_COUNT || s_rates[i] > adc_telemetry_max_rate()) i = 0u;
+    s_rate_hz = s_rates[i];
+
+    if (adc_stream_running()) (void)adc_telemetry_start(s_rate_hz);
+    return s_rate_hz;
+}
+
+void adc_telemetry_pump(void)
+{
+    uint16_t samples[ADC_TELEMETRY_MAX_SAMPLES];
+    uint8_t  payload[ADC_PAYLOAD_MAX];
+
+    while (adc_stream_pending() > 0u)
+    {
+        uint32_t count = adc_stream_read(samples, ADC_TELEMETRY_MAX_SAMPLES);
+        uint32_t len   = encode(payload, samples, count);
+
+        telemetry_send(TELEMETRY_TYPE_ADC, payload, (uint16_t)len);
+
+        s_index     += count;
+        s_raw_bytes += count * 2u;
+        s_enc_bytes += len + TELEMETRY_HEADER_SIZE + TELEMETRY_TRAILER_SIZE;
+    }
+}
+
+void adc_telemetry_report(void)
+{
+    uprint("Stream: %s  rate=%u Hz\r\n", adc_stream_running() ? "on" : "off", s_rate_hz);
+    uprint("Samples: %u  overruns: %u\r\n", s_index, adc_stream_overruns());
+    if (s_enc_bytes != 0u)
+    {
+        uint32_t ratio_x100 = (s_raw_bytes * 100u) / s_enc_bytes;
+        uprint("Wire: %u bytes (raw %u)  ratio %u.%02u\r\n",
+               s_enc_bytes, s_raw_bytes, ratio_x100 / 100u, ratio_x100 % 100u);
+    }
+}
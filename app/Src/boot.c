@@ -0,0 +1,80 @@
+#include "boot.h"
+#include "interface_cycles.h"
+#include "core/uprint.h"
+
+typedef struct
+{
+    uint8_t  index;
+    uint32_t start;
+    uint32_t cycles;
+} boot_record_t;
+
+static const boot_stage_t *s_stages = NULL;
+static boot_record_t       s_records[BOOT_MAX_STAGES];
+static uint8_t             s_record_count = 0u;
+static uint32_t            s_boot_start = 0u;
+static uint32_t            s_boot_end = 0u;
+
+bool boot_run(const boot_stage_t *stages, uint8_t count)
+{
+    if (stages == NULL || count > BOOT_MAX_STAGES) return false;
+
+    cycles_init(CYCLES_DEFAULT_CORE_HZ);
+
+    s_stages       = stages;
+    s_record_count = 0u;
+    s_boot_start   = cycles_now();
+
+    uint32_t all  = (count == 32u) ? 0xFFFFFFFFUL : ((1UL << count) - 1UL);
+    uint32_t done = 0u;
+
+    while (done != all)
+    {
+        bool progressed = false;
+
+        for (uint8_t i = 0u; i < count; i++)
+        {
+            uint32_t bit = 1UL << i;
+            if (done & bit) continue;
+            if (stages[i].deps & ~all) return false;
+            if ((stages[i].deps & done) != stages[i].deps) continue;
+
+            boot_record_t *r = &s_records[s_record_count++];
+            r->index = i;
+            r->start = cycles_now();
+            if (stages[i].init) stages[i].init();
+            r->cycles = cycles_now() - r->start;
+
+            done |= bit;
+            progressed = true;
+        }
+
+        if (!progressed) return false;  /* cycle */
+    }
+
+    s_boot_end = cycles_now();
+    return true;
+}
+
+uint32_t boot_total_us(void)
+{
+    return cycles_to_us(s_boot_end - s_boot_start);
+}
+
+void boot_report(void)
+{
+    if (s_stages == NULL)
+    {
+        uprint("Boot graph not run\r\n");
+        return;
+    }
+
+    uprint("#  stage             start(us)  time(us)\r\n");
+    for (uint8_t i = 0u; i < s_record_count; i++)
+    {
+        const boot_record_t *r = &s_records[i];
+        uprint("%-2u %-16s %10u %9u\r\n", i, s_stages[r->index].name,
+               cycles_to_us(r->start - s_boot_start), cycles_to_us(r->cycles));
+    }
+    uprint("Total: %u us\r\n", boot_total_us());
+}
@@ -13,6 +13,17 @@
 
 #include "interface/interface.h"
 #include "interface_defines.h"
+#include "interface_init.h"
+#include "interface_cycles.h"
+#include "interface_timebase_us.h"
+#include "interface_adc_stream.h"
+#include "interface_record.h"
+#include "interface_control.h"
+#include "interface_trip.h"
+#include "interface_dim.h"
+#include "interface_irq.h"
+#include "interface_usb.h"
+#include "interface_crc.h"
 
 /************************************************************
 *                       COMMON                              *
@@ -31,6 +42,15 @@
 #include "bsp/rtc.h"
 #include "bsp/output.h"
 
+#include "boot.h"
+#include "loopmon.h"
+#include "telemetry.h"
+#include "adc_telemetry.h"
+#include "hal_bench.h"
+#include "image_check.h"
+#include "uprint_fast.h"
+#include "fast_bench.h"
+
 
 static void cmd_status(void);
 static void cmd_leds(void);
@@ -41,6 +61,26 @@ static void cmd_uptime(void);
 static void cmd_rtc(void);
 
 static void cmd_pool(void);
+static void cmd_boot(void);
+static void cmd_loop(void);
+static void cmd_stream(void);
+static void cmd_stream_on(void);
+static void cmd_stream_off(void);
+static void cmd_stream_rate(void);
+static void cmd_rec_on(void);
+static void cmd_rec_off(void);
+static void cmd_rec_dump(void);
+static void cmd_ctrl(void);
+static void cmd_ctrl_on(void);
+static void cmd_ctrl_off(void);
+static void cmd_trip(void);
+static void cmd_dim(void);
+static void cmd_dim_demo(void);
+static void cmd_dim_off(void);
+static void cmd_irq(void);
+static void cmd_irq_reset(void);
+static void cmd_usb(void);
+static void cmd_usb_bench(void);
 
 const command_t commands_table[] = {
     {"help",   cli_help,           "List all commands"},
@@ -52,18 +92,89 @@ const command_t commands_table[] = {
     {"uptime", cmd_uptime,         "Show system uptime"},
     {"rtc",    cmd_rtc,            "Show rtc time"},
     {"pool",   cmd_pool,           "Show memory pool usage"},
+    {"boot",   cmd_boot,           "Show boot stage timings"},
+    {"loop",   cmd_loop,           "Show super-loop latency histogram"},
+    {"stream", cmd_stream,         "Show ADC stream statistics"},
+    {"stream_on", cmd_stream_on,   "Start binary ADC0 stream"},
+    {"stream_off", cmd_stream_off, "Stop binary ADC0 stream"},
+    {"stream_rate", cmd_stream_rate,"Cycle ADC stream sample rate"},
+    {"rec_on", cmd_rec_on,         "Start recording UART/GPIO/ADC inputs"},
+    {"rec_off",cmd_rec_off,        "Stop recording inputs"},
+    {"rec_dump",cmd_rec_dump,      "Send input log as telemetry frames"},
+    {"ctrl",   cmd_ctrl,           "Show control loop timing"},
+    {"ctrl_on",cmd_ctrl_on,        "Start ADC0 -> PID -> Output 1 loop"},
+    {"ctrl_off",cmd_ctrl_off,      "Stop control loop"},
+    {"trip",   cmd_trip,           "Show overcurrent trip latency"},
+    {"dim",    cmd_dim,            "Show LED dimmer ISR load"},
+    {"dim_demo",cmd_dim_demo,      "Dim red/green LEDs (BAM)"},
+    {"dim_off",cmd_dim_off,        "Stop LED dimming"},
+    {"halbench",hal_bench_run,     "Cycles: C dispatch vs C++ HAL"},
+    {"irq",    cmd_irq,            "Show IRQ priorities and worst latency"},
+    {"irq_reset",cmd_irq_reset,    "Clear ISR latency statistics"},
+    {"crc",    image_check_report, "Verify flash image CRC, bench CRC paths"},
+    {"printbench",uprint_bench_run,"Cycles per uprint: fmt vs stock"},
+    {"usb",    cmd_usb,            "Show USB CDC state and counters"},
+    {"usbbench",cmd_usb_bench,     "Send 64 KB over USB CDC, show KB/s"},
+    {"fastbench",fast_bench_run,   "Cycles: flash vs SRAM code per clock profile"},
 };
 
 #define COMMANDS_COUNT (sizeof(commands_table) / sizeof(commands_table[0]))
 
-void config_core(void)
+/************************************************************
+*                      BOOT STAGES                          *
+*************************************************************/
+
+static void stage_pool(void)
 {
     pool_Init();
     poolBig_Init();
-    uprint_setup(BOARD_COMM_SERIAL);
-    cli_setup(BOARD_COMM_SERIAL, (command_t*)commands_table, COMMANDS_COUNT);
+}
+
+static void stage_io(void)
+{
+    IO_init(BOARD_LED_ONBOARD);
+    IO_init(BOARD_LED_RED);
+    IO_init(BOARD_LED_YELLOW);
+    IO_init(BOARD_LED_GREEN);
+
+    IO_init(BOARD_BUTTON_USER);
+    IO_configure(BOARD_BUTTON_USER, IO_OPT_MODE, IO_MODE_INPUT);
+    IO_configure(BOARD_BUTTON_USER, IO_OPT_PULL, IO_PULL_UP);
+}
+
+static void stage_adc(void)
+{
+    analog_init(BOARD_ADC_CHANNEL0);
+}
+
+static void stage_pwm(void)
+{
+    PWM_init(BOARD_PWM_OUTPUT1);
+}
+
+static void stage_serial(void)
+{
+    comm_init(BOARD_COMM_SERIAL);
+}
+
+static void stage_usb(void)
+{
+    comm_init(BOARD_COMM_USB);
+}
+
+static void stage_telemetry(void)
+{
+    telemetry_init(BOARD_COMM_SERIAL);
+}
+
+static void stage_console(void)
+{
+    uprint_setup(BOARD_COMM_CONSOLE);
+    cli_setup(BOARD_COMM_CONSOLE, (command_t*)commands_table, COMMANDS_COUNT);
+}
 
-    // bsp
+static void stage_bsp(void)
+{
     ledPtr_t led = led_createWithUuid("Led Onboard", BOARD_LED_ONBOARD, BOARD_UUID_LED_ONBOARD);
     if(led != NULL)
     {
@@ -89,8 +200,6 @@ void config_core(void)
         led_turn_off(led);
     }
 
-    IO_configure(5, IO_OPT_MODE, IO_MODE_INPUT);
-    IO_configure(5, IO_OPT_PULL, IO_PULL_UP);
     buttonPtr_t button = button_createWithUuid("Button", BOARD_BUTTON_USER, 10, 500, BOARD_UUID_BUTTON_USER);
     if(button != NULL)
     {
@@ -104,18 +213,82 @@ void config_core(void)
     }
 }
 
+static void stage_trip(void)
+{
+    trip_init(BOARD_TRIP_ADC_THRESHOLD, BOARD_TRIP_COMPARATOR != 0);
+}
+
+static void stage_rtc(void)
+{
+    rtc_setup(1);
+
+    RTC_DateTime_t now;
+    rtc_get(&now);
+    timebase_us_sync(&now);
+}
+
+void config_fault(void);
+
+/* Stage ids double as indices into s_boot_stages[] */
+enum
+{
+    STAGE_FPU,
+    STAGE_TIMEBASE,
+    STAGE_IRQ,
+    STAGE_TIMEBASE_US,
+    STAGE_POOL,
+    STAGE_IO,
+    STAGE_ADC,
+    STAGE_CRC,
+    STAGE_PWM,
+    STAGE_SERIAL,
+    STAGE_USB,
+    STAGE_TELEMETRY,
+    STAGE_CONSOLE,
+    STAGE_BSP,
+    STAGE_TRIP,
+    STAGE_RTC,
+    STAGE_FAULT,
+    STAGE_COUNT
+};
+
+/* The console waits only for the comm it runs on */
+#if BOARD_COMM_CONSOLE == BOARD_COMM_USB
+#define STAGE_CONSOLE_COMM  STAGE_USB
+#else
+#define STAGE_CONSOLE_COMM  STAGE_SERIAL
+#endif
+
+static const boot_stage_t s_boot_stages[STAGE_COUNT] = {
+    [STAGE_FPU]         = {"fpu",         fpu_enable,       0},
+    [STAGE_TIMEBASE]    = {"timebase",    timebase_init,    0},
+    [STAGE_IRQ]         = {"irq",         irq_plan_apply,   BOOT_DEP(STAGE_TIMEBASE)},
+    [STAGE_TIMEBASE_US] = {"timebase_us", timebase_us_init, BOOT_DEP(STAGE_IRQ)},
+    [STAGE_POOL]        = {"pool",        stage_pool,       0},
+    [STAGE_IO]          = {"io",          stage_io,         0},
+    [STAGE_ADC]         = {"adc",         stage_adc,        0},
+    [STAGE_CRC]         = {"crc",         crc_init,         0},
+    [STAGE_PWM]         = {"pwm",         stage_pwm,        BOOT_DEP(STAGE_FPU)},
+    [STAGE_SERIAL]      = {"serial",      stage_serial,     BOOT_DEP(STAGE_IRQ)},
+    [STAGE_USB]         = {"usb",         stage_usb,        BOOT_DEP(STAGE_IRQ) | BOOT_DEP(STAGE_TIMEBASE_US)},
+    [STAGE_TELEMETRY]   = {"telemetry",   stage_telemetry,  BOOT_DEP(STAGE_SERIAL)},
+    [STAGE_CONSOLE]     = {"console",     stage_console,    BOOT_DEP(STAGE_CONSOLE_COMM) | BOOT_DEP(STAGE_POOL)},
+    [STAGE_BSP]         = {"bsp",         stage_bsp,        BOOT_DEP(STAGE_IO) | BOOT_DEP(STAGE_PWM) |
+                                                            BOOT_DEP(STAGE_POOL) | BOOT_DEP(STAGE_TIMEBASE)},
+    [STAGE_TRIP]        = {"trip",        stage_trip,       BOOT_DEP(STAGE_ADC) | BOOT_DEP(STAGE_PWM) |
+                                                            BOOT_DEP(STAGE_IO) | BOOT_DEP(STAGE_IRQ)},
+    [STAGE_RTC]         = {"rtc",         stage_rtc,        BOOT_DEP(STAGE_TIMEBASE) | BOOT_DEP(STAGE_TIMEBASE_US)},
+    [STAGE_FAULT]       = {"fault",       config_fault,     BOOT_DEP(STAGE_BSP) | BOOT_DEP(STAGE_CONSOLE) |
+                                                            BOOT_DEP(STAGE_TIMEBASE) | BOOT_DEP(STAGE_TRIP)},
+};
+
 /************************************************************
 *                         APP                               *
 *************************************************************/
 
-void config_fault(void);
-
 void config_app(void)
 {
-    fpu_enable();
-    config_core();
-    rtc_setup(1);
-    config_fault();
+    (void)boot_run(s_boot_stages, STAGE_COUNT);
 }
 
 /************************************************************
@@ -124,6 +297,12 @@ void config_app(void)
 
 static bool detect_overcurrent_output1(void)
 {
+    /* hardware trip already forced Output 1 off, just report it */
+    if(trip_take(NULL))
+    {
+        return true;
+    }
+
     if(button_isPressed(button_getByUuid(BOARD_UUID_BUTTON_USER)))
     {
         return true;
@@ -139,6 +318,7 @@ static void action_overcurrent_output1(void)
 
 static void recover_overcurrent_output1(void)
 {
+    trip_rearm();
     led_turn_off(led_getByUuid(BOARD_UUID_LED_YELLOW));
     uprint("[APP] Output 1 re-enabled after cooldown.\r\n");
 }
@@ -167,10 +347,18 @@ void config_fault(void)
 *                     CLI COMMANDS                          *
 *************************************************************/
 
+/* ms / 1000 == (ms / 8) / 125: one 32-bit divide for the first ~397 days */
+static uint32_t uptime_seconds(void)
+{
+    uint64_t eighths = ticks_get() >> 3;
+
+    if ((eighths >> 32) == 0u) return (uint32_t)eighths / 125u;
+    return (uint32_t)(eighths / 125u);
+}
+
 static void cmd_status(void)
 {
-    uint64_t ms = ticks_get();
-    uint32_t sec = (uint32_t)(ms / 1000);
+    uint32_t sec = uptime_seconds();
     uint32_t min = sec / 60;
     uint32_t hrs = min / 60;
 
@@ -208,8 +396,7 @@ static void cmd_faults(void)
 
 static void cmd_uptime(void)
 {
-    uint64_t ms = ticks_get();
-    uint32_t sec = (uint32_t)(ms / 1000);
+    uint32_t sec = uptime_seconds();
     uint32_t min = sec / 60;
     uint32_t hrs = min / 60;
     uint32_t days = hrs / 24;
@@ -225,6 +412,258 @@ static void cmd_pool(void)
            poolBig_GetFreeBlockCount(), POOL_BIG_BLOCK_COUNT, POOL_BIG_BLOCK_SIZE);
 }
 
+static void cmd_boot(void)
+{
+    boot_report();
+}
+
+static void cmd_loop(void)
+{
+    loopmon_report();
+}
+
+static void cmd_stream(void)
+{
+    adc_telemetry_report();
+}
+
+static void cmd_stream_on(void)
+{
+    if (!adc_telemetry_start(adc_telemetry_rate()))
+    {
+        uprint("Stream start failed (link carries at most %u Hz)\r\n", adc_telemetry_max_rate());
+    }
+}
+
+static void cmd_stream_off(void)
+{
+    adc_telemetry_stop();
+    uprint("Stream stopped\r\n");
+}
+
+static void cmd_stream_rate(void)
+{
+    uprint("Stream rate: %u Hz\r\n", adc_telemetry_next_rate());
+}
+
+static void cmd_rec_on(void)
+{
+    record_start();
+    uprint("Recording inputs (%u bytes)\r\n", RECORD_BUFFER_SIZE);
+}
+
+static void cmd_rec_off(void)
+{
+    uint32_t len;
+    record_stop();
+    (void)record_data(&len);
+    uprint("Recorded %u bytes, %u events dropped\r\n", len, record_dropped());
+}
+
+static void cmd_rec_dump(void)
+{
+    uint32_t len;
+    const uint8_t *data = record_data(&len);
+
+    for (uint32_t off = 0u; off < len; off += TELEMETRY_MAX_PAYLOAD)
+    {
+        uint32_t chunk = len - off;
+        if (chunk > TELEMETRY_MAX_PAYLOAD) chunk = TELEMETRY_MAX_PAYLOAD;
+        telemetry_send(TELEMETRY_TYPE_RECORD, &data[off], (uint16_t)chunk);
+    }
+}
+
+/* Tuned with tools/control_sim against the breadboard RC (tau ~5 ms) */
+#define CTRL_RATE_HZ        10000u
+#define CTRL_SETPOINT       2048        /* ADC counts, ~1.65 V */
+
+static const pid_q16_t ctrl_gains = {
+    .kp      = PID_Q16(0.5f),
+    .ki      = PID_Q16(0.05f),
+    .kd      = 0,
+    .out_min = 0,
+    .out_max = 1000,
+};
+
+static void cmd_ctrl(void)
+{
+    control_stats_t st;
+    control_stats(&st);
+
+    uprint("Control: %s  rate=%u Hz  setpoint=%d\r\n",
+           control_running() ? "on" : "off", control_rate(), control_setpoint());
+    uprint("Runs: %u  missed ADC: %u\r\n", st.runs, st.missed);
+    uprint("Exec: last %u ns  worst %u ns\r\n",
+           cycles_to_ns(st.exec_last_cyc), cycles_to_ns(st.exec_worst_cyc));
+    if (st.period_max_cyc != 0u)
+    {
+        uprint("Period: min %u ns  max %u ns\r\n",
+               cycles_to_ns(st.period_min_cyc), cycles_to_ns(st.period_max_cyc));
+    }
+    uprint("Meas: %d  Out: %d\r\n", st.last_meas, st.last_out);
+}
+
+static void cmd_ctrl_on(void)
+{
+    if (!control_start(CTRL_RATE_HZ, &ctrl_gains, CTRL_SETPOINT))
+    {
+        uprint("Control start failed (ADC stream running or trip latched?)\r\n");
+    }
+}
+
+static void cmd_ctrl_off(void)
+{
+    control_stop();
+    uprint("Control stopped\r\n");
+}
+
+static void cmd_trip(void)
+{
+    static const char *const src[] = { "none", "adc watchdog", "comparator" };
+    trip_stats_t st;
+    trip_stats(&st);
+
+    uprint("Trips: %u  latched: %s  last: %s\r\n",
+           st.count, trip_latched() ? "yes" : "no", src[st.last_source]);
+    uprint("Output off: last %u ns  worst %u ns (from ISR entry)\r\n",
+           cycles_to_ns(st.react_last_cyc), cycles_to_ns(st.react_worst_cyc));
+    uprint("Fault post: last %u us  worst %u us\r\n",
+           cycles_to_us(st.post_last_cyc), cycles_to_us(st.post_worst_cyc));
+}
+
+/* Yellow is the overcurrent indicator, so it stays with the fault action; blinky skips red while dimmed */
+static const uint8_t dim_leds[]      = { BOARD_LED_RED, BOARD_LED_GREEN };
+static const uint8_t dim_led_uuids[] = { BOARD_UUID_LED_RED, BOARD_UUID_LED_GREEN };
+#define DIM_LED_COUNT   (sizeof(dim_leds) / sizeof(dim_leds[0]))
+
+static void cmd_dim(void)
+{
+    dim_stats_t st;
+    dim_stats(&st);
+
+    uprint("Dimmer: %s  frame=%u Hz  %u planes\r\n",
+           dim_running() ? "on" : "off", st.frame_hz, DIM_BITS);
+    uprint("ISR: avg %u ns  worst %u ns  (%u runs)\r\n",
+           cycles_to_ns(st.isr_avg_cyc), cycles_to_ns(st.isr_worst_cyc), st.isr_count);
+    uprint("CPU load: %u.%02u %%\r\n", st.load_ppm / 10000u, (st.load_ppm / 100u) % 100u);
+}
+
+static void dim_release(void)
+{
+    dim_stop();
+    for (uint8_t i = 0u; i < DIM_LED_COUNT; i++)
+    {
+        dim_detach(dim_leds[i]);
+        led_turn_off(led_getByUuid(dim_led_uuids[i]));
+    }
+}
+
+static void cmd_dim_demo(void)
+{
+    static const uint8_t levels[DIM_LED_COUNT] = { 48u, 255u };
+
+    for (uint8_t i = 0u; i < DIM_LED_COUNT; i++)
+    {
+        if (!dim_attach(dim_leds[i], false))
+        {
+            dim_release();
+            uprint("Dim attach failed (pin %u)\r\n", dim_leds[i]);
+            return;
+        }
+        dim_set(dim_leds[i], levels[i]);
+    }
+
+    if (!dim_start(DIM_DEFAULT_HZ))
+    {
+        dim_release();
+        uprint("Dim start failed\r\n");
+    }
+}
+
+static void cmd_dim_off(void)
+{
+    dim_release();
+}
+
+static void cmd_irq(void)
+{
+    uprint("IRQ      prio  runs        lat worst   dur last   dur worst\r\n");
+    for (uint8_t i = 0u; i < IRQ_SRC_COUNT; i++)
+    {
+        const irq_plan_entry_t *e = irq_plan_get((irq_source_t)i);
+        irq_profile_t p;
+        irq_profile_get((irq_source_t)i, &p);
+
+        if (i == IRQ_SRC_SYSTICK)
+        {
+            uprint("%-8s %u.%u   -\r\n", e->name, e->preempt, e->sub);
+            continue;
+        }
+
+        uprint("%-8s %u.%u   %-10u  ", e->name, e->preempt, e->sub, p.count);
+        if (p.lat_worst_cyc != 0u) uprint("%6u ns   ", cycles_to_ns(p.lat_worst_cyc));
+        else                       uprint("     -      ");
+        uprint("%6u ns  %6u ns\r\n", cycles_to_ns(p.dur_last_cyc), cycles_to_ns(p.dur_worst_cyc));
+    }
+}
+
+static void cmd_irq_reset(void)
+{
+    irq_profile_reset();
+}
+
+static void cmd_usb(void)
+{
+    usb_cdc_line_coding_t lc;
+    usb_cdc_stats_t       st;
+    usb_cdc_line_coding(&lc);
+    usb_cdc_stats(&st);
+
+    if (!usb_cdc_init_ok())
+    {
+        uprint("USB CDC: init failed (no HSE/PLL lock or core reset timeout)\r\n");
+        return;
+    }
+
+    uprint("USB CDC: %s, DTR %s, %u baud %u%c%u\r\n",
+           usb_cdc_configured() ? "configured" : "not configured",
+           usb_cdc_dtr() ? "on" : "off",
+           lc.baud, lc.data_bits, "NOEMS"[lc.parity % 5u], (lc.stop_bits == 2u) ? 2u : 1u);
+    uprint("TX: %u bytes  %u packets  %u dropped\r\n", st.tx_bytes, st.tx_packets, st.tx_dropped);
+    uprint("RX: %u bytes  %u packets  %u NAKed\r\n", st.rx_bytes, st.rx_packets, st.rx_naks);
+    uprint("Bus resets: %u\r\n", st.resets);
+}
+
+#define USB_BENCH_BYTES     (64u * 1024u)
+
+static void cmd_usb_bench(void)
+{
+    static uint8_t chunk[USB_CDC_PACKET];
+    usb_cdc_stats_t before, after;
+
+    if (!usb_cdc_dtr())
+    {
+        uprint("USB CDC: no host with the port open\r\n");
+        return;
+    }
+
+    for (uint8_t i = 0u; i < sizeof(chunk); i++) chunk[i] = (uint8_t)('0' + (i % 64u));
+
+    usb_cdc_stats(&before);
+    uint32_t start = cycles_now();
+    for (uint32_t sent = 0u; sent < USB_BENCH_BYTES; sent += sizeof(chunk))
+    {
+        comm_send(BOARD_COMM_USB, chunk, sizeof(chunk));
+    }
+    uint32_t us = cycles_to_us(cycles_now() - start);
+    usb_cdc_stats(&after);
+
+    uint32_t dropped = after.tx_dropped - before.tx_dropped;
+    uprint("USB CDC: %u bytes in %u us -> %u KB/s, %u dropped\r\n",
+           USB_BENCH_BYTES, us, (us != 0u) ? (uint32_t)((uint64_t)USB_BENCH_BYTES * 1000000u / 1024u / us) : 0u,
+           dropped);
+}
+
 static void cmd_rtc(void)
 {
     RTC_DateTime_t rtc;
@@ -0,0 +1,159 @@
+#include "fast_bench.h"
+#include "interface_fast.h"
+#include "interface_cycles.h"
+#include "interface_irq.h"
+#include "core/uprint.h"
+
+#include <stdbool.h>
+
+/* ------------------------------------------------------------------ */
+/*  Flash interface                                                   */
+/* ------------------------------------------------------------------ */
+
+#define FLASH_ACR_REG           (*(volatile uint32_t *)0x40023C00UL)
+#define FLASH_ACR_LATENCY_MASK  0xFu
+#define FLASH_ACR_PRFTEN        (1u << 8)
+#define FLASH_ACR_ICEN          (1u << 9)
+#define FLASH_ACR_DCEN          (1u << 10)
+#define FLASH_ACR_ICRST         (1u << 11)
+#define FLASH_ACR_DCRST         (1u << 12)
+#define FLASH_ACR_ART           (FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN)
+
+#define BENCH_RUNS              8u
+#define BENCH_ITEMS             64u
+#define BENCH_RING_SIZE         32u
+
+typedef struct
+{
+    const char *name;
+    uint8_t     wait_states;
+} clock_profile_t;
+
+/* RM0383, 2.7 - 3.6 V */
+static const clock_profile_t s_profiles[] = {
+    { "16 MHz HSI",   0u },
+    { "48 MHz PLL",   1u },
+    { "84 MHz PLL",   2u },
+    { "100 MHz PLL",  3u },
+};
+
+#define PROFILE_COUNT   (sizeof(s_profiles) / sizeof(s_profiles[0]))
+
+typedef struct
+{
+    uint8_t buf[BENCH_RING_SIZE];
+    uint8_t head;
+    uint8_t tail;
+} bench_ring_t;
+
+/* ------------------------------------------------------------------ */
+/*  Workload — one body, two placements                               */
+/* ------------------------------------------------------------------ */
+
+static inline __attribute__((always_inline)) uint32_t bench_body(bench_ring_t *rb, uint32_t n)
+{
+    uint32_t acc = 0u;
+
+    for (uint32_t i = 0u; i < n; i++)
+    {
+        uint8_t next = (uint8_t)((rb->head + 1u) & (BENCH_RING_SIZE - 1u));
+        if (next != rb->tail)
+        {
+            rb->buf[rb->head] = (uint8_t)(i * 37u);
+            rb->head = next;
+        }
+
+        if ((i & 3u) != 3u) continue;
+
+        while (rb->tail != rb->head)
+        {
+            uint8_t b = rb->buf[rb->tail];
+            rb->tail = (uint8_t)((rb->tail + 1u) & (BENCH_RING_SIZE - 1u));
+
+            if      ((b & 3u) == 0u) acc += b;
+            else if ((b & 3u) == 1u) acc ^= (uint32_t)b << 3;
+            else if ((b & 3u) == 2u) acc -= b;
+            else                     acc  = (acc << 1) | (acc >> 31);
+        }
+    }
+    return acc;
+}
+
+static __attribute__((noinline)) uint32_t bench_flash(bench_ring_t *rb, uint32_t n)
+{
+    return bench_body(rb, n);
+}
+
+FAST_CODE static uint32_t bench_ram(bench_ring_t *rb, uint32_t n)
+{
+    return bench_body(rb, n);
+}
+
+typedef uint32_t (*bench_fn_t)(bench_ring_t *rb, uint32_t n);
+
+/* ------------------------------------------------------------------ */
+/*  Private helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+/* Caches may only be reset while disabled */
+static void flash_set(uint8_t wait_states, bool art)
+{
+    uint32_t acr = FLASH_ACR_REG & ~(FLASH_ACR_LATENCY_MASK | FLASH_ACR_ART);
+
+    FLASH_ACR_REG = acr | wait_states;
+    while ((FLASH_ACR_REG & FLASH_ACR_LATENCY_MASK) != wait_states) {}
+
+    FLASH_ACR_REG = acr | wait_states | FLASH_ACR_ICRST | FLASH_ACR_DCRST;
+    FLASH_ACR_REG = acr | wait_states;
+    if (art) FLASH_ACR_REG = acr | wait_states | FLASH_ACR_ART;
+}
+
+static uint32_t bench_best(bench_fn_t fn)
+{
+    static bench_ring_t rb;
+    uint32_t best = 0xFFFFFFFFu;
+
+    for (uint32_t i = 0u; i < BENCH_RUNS; i++)
+    {
+        rb.head = rb.tail = 0u;
+
+        uint32_t primask = irq_save_all();     /* nothing, trips included, inside the window */
+        uint32_t t0      = cycles_now();
+        (void)fn(&rb, BENCH_ITEMS);
+        uint32_t dt      = cycles_now() - t0;
+        irq_restore_all(primask);
+
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+void fast_bench_run(void)
+{
+    uint32_t saved = FLASH_ACR_REG;
+    uint32_t cyc[PROFILE_COUNT][3];
+
+    for (uint8_t p = 0u; p < PROFILE_COUNT; p++)
+    {
+        flash_set(s_profiles[p].wait_states, false);
+        cyc[p][0] = bench_best(bench_flash);
+        flash_set(s_profiles[p].wait_states, true);
+        cyc[p][1] = bench_best(bench_flash);
+        cyc[p][2] = bench_best(bench_ram);
+    }
+
+    flash_set((uint8_t)(saved & FLASH_ACR_LATENCY_MASK), (saved & FLASH_ACR_ICEN) != 0u);
+    FLASH_ACR_REG = saved;
+
+    uprint("Profile      WS   flash   flash+ART   SRAM   (cycles, %u items)\r\n", BENCH_ITEMS);
+    for (uint8_t p = 0u; p < PROFILE_COUNT; p++)
+    {
+        uprint("%-12s %u   %6u   %6u   %6u\r\n", s_profiles[p].name, s_profiles[p].wait_states,
+               cyc[p][0], cyc[p][1], cyc[p][2]);
+    }
+    uprint(".fast: %u bytes in SRAM (map_report.py flash.map --output-section .fast)\r\n", fast_size());
+}
@@ -0,0 +1,93 @@
+#include "hal_bench.h"
+#include "board_config.h"
+#include "interface_hal.hpp"
+
+extern "C" {
+#include "interface/interface.h"
+#include "interface_cycles.h"
+#include "core/uprint.h"
+}
+
+#define BENCH_RUNS      16u
+#define BENCH_NOINLINE  __attribute__((noinline))
+
+typedef board::Io<BOARD_LED_GREEN>::type    GreenLed;
+typedef board::Io<BOARD_LED_RED>::type      RedLed;
+typedef board::Io<BOARD_LED_YELLOW>::type   YellowLed;
+typedef hal::PinGroup<RedLed, YellowLed, GreenLed> TrafficLights;
+typedef board::Pwm<BOARD_PWM_OUTPUT1>::type Output1;
+
+/************************************************************
+*                   MEASURED PATHS                          *
+*************************************************************/
+
+extern "C" BENCH_NOINLINE void bench_c_io_write(uint8_t value)
+{
+    IO_write(BOARD_LED_GREEN, value);
+}
+
+extern "C" BENCH_NOINLINE void bench_hal_io_write(uint8_t value)
+{
+    GreenLed::write(value != 0u);
+}
+
+extern "C" BENCH_NOINLINE void bench_c_group_write(uint8_t value)
+{
+    IO_write(BOARD_LED_RED,    (value >> 0) & 1u);
+    IO_write(BOARD_LED_YELLOW, (value >> 1) & 1u);
+    IO_write(BOARD_LED_GREEN,  (value >> 2) & 1u);
+}
+
+extern "C" BENCH_NOINLINE void bench_hal_group_write(uint8_t value)
+{
+    TrafficLights::write(value);
+}
+
+extern "C" BENCH_NOINLINE void bench_c_pwm_set(uint32_t permille)
+{
+    PWM_set_duty(BOARD_PWM_OUTPUT1, (float)permille / 10.0f);
+}
+
+extern "C" BENCH_NOINLINE void bench_hal_pwm_set(uint32_t permille)
+{
+    Output1::set_permille(permille);
+}
+
+/************************************************************
+*                       HARNESS                             *
+*************************************************************/
+
+template <typename Fn, typename Arg>
+static uint32_t best_of(Fn fn, Arg arg)
+{
+    uint32_t best = 0xFFFFFFFFu;
+    for (uint32_t i = 0u; i < BENCH_RUNS; i++)
+    {
+        uint32_t t0 = cycles_now();
+        fn(arg);
+        uint32_t dt = cycles_now() - t0;
+        if (dt < best) best = dt;
+    }
+
+    /* subtract the cost of the measurement itself */
+    uint32_t t0 = cycles_now();
+    uint32_t overhead = cycles_now() - t0;
+    return (best > overhead) ? (best - overhead) : 0u;
+}
+
+static void report(const char *name, uint32_t c_cyc, uint32_t hal_cyc)
+{
+    uprint("%-12s C %4u cyc   C++ %4u cyc\r\n", name, c_cyc, hal_cyc);
+}
+
+extern "C" void hal_bench_run(void)
+{
+    uint8_t green = 0u;
+    IO_read(BOARD_LED_GREEN, &green);
+
+    report("io write",   best_of(bench_c_io_write, green),    best_of(bench_hal_io_write, green));
+    report("3-pin write",best_of(bench_c_group_write, 0u),    best_of(bench_hal_group_write, 0u));
+    report("pwm 50%",    best_of(bench_c_pwm_set, 500u),      best_of(bench_hal_pwm_set, 500u));
+
+    uprint("Code size: see .text.bench_c_* / .text.bench_hal_* in flash.map\r\n");
+}
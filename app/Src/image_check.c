@@ -0,0 +1,86 @@
+#include "image_check.h"
+#include "interface_crc.h"
+#include "interface_cycles.h"
+#include "interface_fast.h"
+#include "core/uprint.h"
+
+#define FLASH_IMAGE_BASE    0x08000000UL
+#define CRC_BENCH_BYTES     4096u
+#define CRC_TRAILER_ERASED  0xFFFFFFFFu
+
+/* From the linker script: .data's load address and run extent */
+extern const uint32_t _sidata;
+extern uint32_t       _sdata;
+extern uint32_t       _edata;
+
+/*
+ * The image ends with the last load image in flash: .data's, or .fast's
+ * where app/fast_ram.ld places it after .data. Take the later of the two
+ * so either layout is covered.
+ */
+static uint32_t image_length(void)
+{
+    uint32_t data_end = (uint32_t)(uintptr_t)&_sidata
+                      + (uint32_t)((uintptr_t)&_edata - (uintptr_t)&_sdata);
+    uint32_t fast_end = fast_load_end();
+    uint32_t end      = (fast_end > data_end) ? fast_end : data_end;
+
+    return (end - FLASH_IMAGE_BASE + 3u) & ~3u;
+}
+
+void image_check_run(image_check_t *out)
+{
+    if (out == NULL) return;
+
+    const uint32_t *image = (const uint32_t *)FLASH_IMAGE_BASE;
+
+    out->base     = FLASH_IMAGE_BASE;
+    out->length   = image_length();
+    out->stored   = image[out->length / 4u];
+    out->sealed   = (out->stored != CRC_TRAILER_ERASED);
+
+    uint32_t t0   = cycles_now();
+    out->computed = crc32_words(CRC32_INIT, image, out->length / 4u);
+    out->cycles   = cycles_now() - t0;
+
+    out->ok       = out->sealed && (out->computed == out->stored);
+}
+
+/* bytes per cycle as x.xx */
+static void report_path(const char *name, uint32_t crc, uint32_t cycles)
+{
+    uint32_t bpc100 = (cycles != 0u) ? (uint32_t)((CRC_BENCH_BYTES * 100ULL) / cycles) : 0u;
+    uprint("  %-9s %08X  %7u cyc  %u.%02u B/cyc\r\n",
+           name, crc, cycles, bpc100 / 100u, bpc100 % 100u);
+}
+
+void image_check_report(void)
+{
+    image_check_t r;
+    image_check_run(&r);
+
+    uprint("Image 0x%08X + %u bytes  crc %08X  (%u us)\r\n",
+           r.base, r.length, r.computed, cycles_to_us(r.cycles));
+    if (!r.sealed)  uprint("Not sealed (flashed without image_crc.py?)\r\n");
+    else if (r.ok)  uprint("Trailer %08X: OK\r\n", r.stored);
+    else            uprint("Trailer %08X: MISMATCH\r\n", r.stored);
+
+    /* same 4 KB of flash through each path — all three must agree */
+    const uint32_t *block = (const uint32_t *)FLASH_IMAGE_BASE;
+    const uint32_t  words = CRC_BENCH_BYTES / 4u;
+    uint32_t t0, crc;
+
+    uprint("CRC-32 over %u bytes:\r\n", CRC_BENCH_BYTES);
+
+    t0  = cycles_now();
+    crc = crc32_words_sw(CRC32_INIT, block, words);
+    report_path("software", crc, cycles_now() - t0);
+
+    t0  = cycles_now();
+    crc = crc32_words_hw(CRC32_INIT, block, words);
+    report_path("unit/cpu", crc, cycles_now() - t0);
+
+    t0  = cycles_now();
+    crc = crc32_words_dma(CRC32_INIT, block, words);
+    report_path("unit/dma", crc, cycles_now() - t0);
+}
@@ -0,0 +1,167 @@
+#include "loopmon.h"
+#include "interface_cycles.h"
+#include "interface_watchdog.h"
+#include "core/uprint.h"
+
+#include <string.h>
+
+#define LOOPMON_SERIAL_SIZE  (4u * 3u + 2u + 4u * LOOPMON_BUCKETS)
+
+static const char *const *s_names = NULL;
+static uint8_t            s_count = 0u;
+static uint32_t           s_deadline_us = 0u;
+static uint32_t           s_deadline_cyc = 0u;
+static uint32_t           s_cyc_per_us = 1u;
+static bool               s_feed_watchdog = false;
+
+static loopmon_stats_t    s_stats;
+
+static uint32_t           s_iter_start = 0u;
+static uint32_t           s_mark = 0u;
+static uint32_t           s_iter_slowest_cyc = 0u;
+static uint8_t            s_iter_slowest = 0u;
+
+static uint8_t bucket_of(uint32_t us)
+{
+    if (us < 2u) return 0u;
+    uint8_t b = (uint8_t)(31u - (uint32_t)__builtin_clz(us));
+    return (b >= LOOPMON_BUCKETS) ? (uint8_t)(LOOPMON_BUCKETS - 1u) : b;
+}
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+void loopmon_init(const char *const *component_names, uint8_t count, uint32_t deadline_us)
+{
+    s_names       = component_names;
+    s_count       = (count > LOOPMON_MAX_COMPONENTS) ? LOOPMON_MAX_COMPONENTS : count;
+    s_deadline_us = deadline_us;
+
+    /* whole MHz core clocks (16, 48, 84, 100), so the divide is exact */
+    s_cyc_per_us   = cycles_core_hz() / 1000000u;
+    if (s_cyc_per_us == 0u) s_cyc_per_us = 1u;
+    s_deadline_cyc = deadline_us * s_cyc_per_us;
+    loopmon_reset();
+}
+
+void loopmon_watchdog_enable(uint32_t timeout_ms)
+{
+    (void)watchdog_init(timeout_ms);
+    s_feed_watchdog = true;
+}
+
+void loopmon_begin(void)
+{
+    s_iter_start      = cycles_now();
+    s_mark            = s_iter_start;
+    s_iter_slowest_cyc = 0u;
+    s_iter_slowest     = 0u;
+}
+
+void loopmon_mark(uint8_t component)
+{
+    uint32_t now = cycles_now();
+    uint32_t cyc = now - s_mark;
+    s_mark = now;
+
+    if (component >= s_count) return;
+
+    if (cyc > s_stats.component_worst_cyc[component])
+    {
+        s_stats.component_worst_cyc[component] = cyc;
+    }
+    if (cyc >= s_iter_slowest_cyc)
+    {
+        s_iter_slowest_cyc = cyc;
+        s_iter_slowest     = component;
+    }
+}
+
+void loopmon_end(void)
+{
+    uint32_t cyc = cycles_now() - s_iter_start;
+
+    s_stats.iterations++;
+    s_stats.histogram[bucket_of(cyc / s_cyc_per_us)]++;
+
+    if (cyc > s_stats.worst_cyc)
+    {
+        s_stats.worst_cyc       = cyc;
+        s_stats.worst_component = s_iter_slowest;
+    }
+
+    if (s_deadline_cyc != 0u && cyc > s_deadline_cyc)
+    {
+        s_stats.deadline_misses++;
+        return;     /* starve the watchdog */
+    }
+
+    if (s_feed_watchdog) watchdog_feed();
+}
+
+const loopmon_stats_t *loopmon_stats(void)
+{
+    return &s_stats;
+}
+
+void loopmon_reset(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void loopmon_report(void)
+{
+    const char *worst = (s_names && s_stats.worst_component < s_count)
+                      ? s_names[s_stats.worst_component] : "?";
+
+    uprint("Iterations: %u  Deadline: %u us  Misses: %u\r\n",
+           s_stats.iterations, s_deadline_us, s_stats.deadline_misses);
+    uprint("Worst: %u us (%s)\r\n", cycles_to_us(s_stats.worst_cyc), worst);
+
+    for (uint8_t i = 0u; i < s_count; i++)
+    {
+        uprint("  %-8s worst %u us\r\n", s_names[i], cycles_to_us(s_stats.component_worst_cyc[i]));
+    }
+
+    for (uint8_t b = 0u; b < LOOPMON_BUCKETS; b++)
+    {
+        if (s_stats.histogram[b] == 0u) continue;
+        if (b == 0u)
+        {
+            uprint("  <2 us        %u\r\n", s_stats.histogram[b]);
+        }
+        else if (b == LOOPMON_BUCKETS - 1u)
+        {
+            uprint("  >=%-6u us  %u\r\n", 1UL << b, s_stats.histogram[b]);
+        }
+        else
+        {
+            uprint("  %5u-%-6u  %u\r\n", 1UL << b, (1UL << (b + 1u)) - 1u, s_stats.histogram[b]);
+        }
+    }
+}
+
+uint32_t loopmon_serialize(uint8_t *buf, uint32_t len)
+{
+    if (buf == NULL || len < LOOPMON_SERIAL_SIZE) return 0u;
+
+    put_u32(&buf[0], s_stats.iterations);
+    put_u32(&buf[4], s_stats.deadline_misses);
+    put_u32(&buf[8], cycles_to_us(s_stats.worst_cyc));
+    buf[12] = s_stats.worst_component;
+    buf[13] = (uint8_t)LOOPMON_BUCKETS;
+    for (uint8_t b = 0u; b < LOOPMON_BUCKETS; b++)
+    {
+        put_u32(&buf[14u + 4u * b], s_stats.histogram[b]);
+    }
+    return LOOPMON_SERIAL_SIZE;
+}
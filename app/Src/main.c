@@ -10,11 +10,39 @@
 #include "bsp/rtc.h"
 #include "bsp/button.h"
 
+#include "loopmon.h"
+#include "telemetry.h"
+#include "adc_telemetry.h"
+#include "interface_adc_stream.h"
+#include "interface_fast.h"
+#include "interface_dim.h"
+
+/* Super-loop budget; the IWDG is only fed by iterations that meet it */
+#define LOOP_DEADLINE_US    20000u
+#define LOOP_WATCHDOG_MS    0u      /* 0 = watchdog not started */
+
+enum
+{
+    LOOP_COMP_TICKER,
+    LOOP_COMP_CLI,
+    LOOP_COMP_FAULT,
+    LOOP_COMP_COUNT
+};
+
+static const char *const loop_components[LOOP_COMP_COUNT] = {
+    [LOOP_COMP_TICKER] = "ticker",
+    [LOOP_COMP_CLI]    = "cli",
+    [LOOP_COMP_FAULT]  = "fault",
+};
+
 
 static void task_blinky(void)
 {
     led_toggle(led_getByUuid(BOARD_UUID_LED_ONBOARD));
-    led_toggle(led_getByUuid(BOARD_UUID_LED_RED));
+    if (!dim_owns(BOARD_LED_RED))
+    {
+        led_toggle(led_getByUuid(BOARD_UUID_LED_RED));
+    }
 }
 
 static void task_button(void)
@@ -22,23 +50,48 @@ static void task_button(void)
     button_update(button_getByUuid(BOARD_UUID_BUTTON_USER));
 }
 
+static void task_telemetry(void)
+{
+    adc_telemetry_pump();
+}
+
+static void task_loop_telemetry(void)
+{
+    if (!adc_stream_running()) return;
+
+    uint8_t  buf[96];
+    uint32_t len = loopmon_serialize(buf, sizeof(buf));
+    telemetry_send(TELEMETRY_TYPE_LOOP, buf, (uint16_t)len);
+}
+
 static const ticker_task_t app_tasks[] = {
-    TICKER_TASK(task_blinky,  500),
-    TICKER_TASK(task_button,  10),
+    TICKER_TASK(task_blinky,         500),
+    TICKER_TASK(task_button,         10),
+    TICKER_TASK(task_telemetry,      10),
+    TICKER_TASK(task_loop_telemetry, 1000),
 };
 
 int main(void)
 {
+    fast_copy_init();
     config_app();
 
     ticker_init(app_tasks, TICKER_TASK_COUNT(app_tasks));
 
+    loopmon_init(loop_components, LOOP_COMP_COUNT, LOOP_DEADLINE_US);
+    if (LOOP_WATCHDOG_MS != 0u)
+    {
+        loopmon_watchdog_enable(LOOP_WATCHDOG_MS);
+    }
+
     uprint("Init the board!\r\n");
 
     while(1)
     {
-        ticker_update();
-        cli_update();
-        fault_update();
+        loopmon_begin();
+        ticker_update();    loopmon_mark(LOOP_COMP_TICKER);
+        cli_update();       loopmon_mark(LOOP_COMP_CLI);
+        fault_update();     loopmon_mark(LOOP_COMP_FAULT);
+        loopmon_end();
     }
 }
@@ -0,0 +1,86 @@
+#include "telemetry.h"
+#include "interface/interface.h"
+#include "interface_comm.h"
+#include "interface_defines.h"
+
+static uint8_t  s_comm_id = 0u;
+static uint8_t  s_seq = 0u;
+static uint32_t s_frames = 0u;
+
+void telemetry_init(uint8_t comm_id)
+{
+    s_comm_id = comm_id;
+    s_seq     = 0u;
+    s_frames  = 0u;
+}
+
+uint16_t telemetry_fletcher16(uint16_t state, const uint8_t *data, uint32_t len)
+{
+    uint16_t s1 = state & 0xFFu;
+    uint16_t s2 = state >> 8;
+
+    for (uint32_t i = 0u; i < len; i++)
+    {
+        s1 = (uint16_t)((s1 + data[i]) % 255u);
+        s2 = (uint16_t)((s2 + s1) % 255u);
+    }
+    return (uint16_t)((s2 << 8) | s1);
+}
+
+uint32_t telemetry_put_varint(uint8_t *out, uint32_t value)
+{
+    uint32_t n = 0u;
+    while (value >= 0x80u)
+    {
+        out[n++] = (uint8_t)(value | 0x80u);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+bool telemetry_send(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    if (len > TELEMETRY_MAX_PAYLOAD || (len != 0u && payload == NULL)) return false;
+
+    uint8_t header[TELEMETRY_HEADER_SIZE];
+    uint8_t trailer[TELEMETRY_TRAILER_SIZE];
+
+    header[0] = TELEMETRY_SYNC0;
+    header[1] = TELEMETRY_SYNC1;
+    header[2] = type;
+    header[3] = s_seq++;
+    header[4] = (uint8_t)(len);
+    header[5] = (uint8_t)(len >> 8);
+
+    uint16_t sum = telemetry_fletcher16(0u, &header[2], 4u);
+    sum = telemetry_fletcher16(sum, payload, len);
+    trailer[0] = (uint8_t)(sum);
+    trailer[1] = (uint8_t)(sum >> 8);
+
+    /* payload goes out in place, no frame buffer */
+    const comm_iovec_t iov[3] = {
+        { header,  sizeof(header)  },
+        { payload, len             },
+        { trailer, sizeof(trailer) },
+    };
+    comm_sendv(s_comm_id, iov, 3u);
+
+    s_frames++;
+    return true;
+}
+
+uint32_t telemetry_frames_sent(void)
+{
+    return s_frames;
+}
+
+uint32_t telemetry_link_budget(void)
+{
+    switch (s_comm_id)
+    {
+        case INTERFACE_PROTOCOL_UART2:   return TELEMETRY_UART2_BYTES_PER_SEC;
+        case INTERFACE_PROTOCOL_USB_CDC: return TELEMETRY_USB_BYTES_PER_SEC;
+        default:                         return 0u;
+    }
+}
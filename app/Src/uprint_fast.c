@@ -0,0 +1,85 @@
+#include "uprint_fast.h"
+#include "board_config.h"
+#include "fmt.h"
+#include "interface/interface.h"
+#include "interface_cycles.h"
+#include "core/uprint.h"
+
+#include <stdarg.h>
+
+#define UPRINT_COMM_NONE    0xFFu       /* no instance: comm_send drops it */
+#define BENCH_RUNS          8u
+
+static uint8_t s_uprint_comm = UPRINT_COMM_NONE;
+
+void __real_uprint_setup(uint8_t comm_id);
+void __real_uprint(const char *format, ...);
+
+static void comm_sink(void *ctx, const char *data, uint32_t len)
+{
+    comm_send(*(const uint8_t *)ctx, (uint8_t *)data, len);
+}
+
+void __wrap_uprint_setup(uint8_t comm_id)
+{
+    s_uprint_comm = comm_id;
+    __real_uprint_setup(comm_id);
+}
+
+void __wrap_uprint(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    (void)fmt_vformat(comm_sink, &s_uprint_comm, format, ap);
+    va_end(ap);
+}
+
+/************************************************************
+*                       BENCHMARK                           *
+*************************************************************/
+
+typedef void (*print_fn_t)(const char *format, ...);
+
+/* Representative lines from the CLI commands */
+static uint32_t bench_lines(print_fn_t print)
+{
+    uint32_t best = 0xFFFFFFFFu;
+
+    for (uint32_t i = 0u; i < BENCH_RUNS; i++)
+    {
+        uint32_t t0 = cycles_now();
+        print("Uptime: %uh %um %us\r\n", 27u, 14u, 9u);
+        print("ADC0 (PA1): raw=%u  voltage=%u mV\r\n", 2048u, 1650u);
+        print("%-8s %u.%u   %-10u  %6u ns\r\n", "usart2", 1u, 1u, 123456u, 2875u);
+        print("Image 0x%08X + %u bytes  crc %08X\r\n", 0x08000000u, 48212u, 0xB51EF243u);
+        uint32_t dt = cycles_now() - t0;
+        if (dt < best) best = dt;
+    }
+    return best / 4u;
+}
+
+void uprint_bench_run(void)
+{
+    __wrap_uprint_setup(UPRINT_COMM_NONE);
+    uint32_t fast = bench_lines(__wrap_uprint);
+
+    uint64_t big = 123456789012345ull;
+    uint32_t t0  = cycles_now();
+    __wrap_uprint("%llu %.3llq\r\n", big, (int64_t)big);
+    uint32_t wide = cycles_now() - t0;
+
+#ifdef UPRINT_BENCH
+    uint32_t stock = bench_lines(__real_uprint);
+#endif
+
+    __wrap_uprint_setup(BOARD_COMM_CONSOLE);
+
+    uprint("fmt uprint:   %5u cyc/call\r\n", fast);
+#ifdef UPRINT_BENCH
+    uprint("stock uprint: %5u cyc/call\r\n", stock);
+#else
+    uprint("stock uprint: not linked (-DUPRINT_BENCH=ON)\r\n");
+#endif
+    uprint("64-bit + fixed-point line: %u cyc\r\n", wide);
+    uprint("Flash: tools/map_report.py flash.map --match 'fmt|vfprintf|uprint'\r\n");
+}
@@ -0,0 +1,35 @@
+/**
+ * @file control_pid.h
+ * @brief Fixed-point PID (Q16.16 gains), host-safe
+ *
+ * Gains are per sample: ki already includes the sample period and kd
+ * already includes its inverse. The derivative acts on the measurement
+ * to avoid setpoint kicks. Anti-windup clamps the integrator to the
+ * output range and freezes it while the output is saturated in the
+ * direction of the error.
+ */
+
+#ifndef INC_CONTROL_PID_H_
+#define INC_CONTROL_PID_H_
+
+#include <stdint.h>
+
+#define PID_Q16_ONE         65536
+#define PID_Q16(x)          ((int32_t)((x) * 65536.0f))
+
+typedef struct
+{
+    int32_t kp;             /* Q16.16 */
+    int32_t ki;             /* Q16.16, per sample */
+    int32_t kd;             /* Q16.16, per sample */
+    int32_t out_min;
+    int32_t out_max;
+
+    int64_t integ;          /* Q16.16 */
+    int32_t prev_meas;
+} pid_q16_t;
+
+void    pid_q16_reset(pid_q16_t *pid, int32_t meas);
+int32_t pid_q16_update(pid_q16_t *pid, int32_t setpoint, int32_t meas);
+
+#endif /* INC_CONTROL_PID_H_ */
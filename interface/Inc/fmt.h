@@ -0,0 +1,42 @@
+/**
+ * @file fmt.h
+ * @brief Allocation-free printf subset with 64-bit and fixed-point output
+ *
+ * Output goes through a small chunk buffer on the caller's stack
+ * (FMT_CHUNK_SIZE bytes) to a sink callback. A line of any length never
+ * needs a full-line buffer, and no heap is used. Stack use is bounded:
+ * chunk + one 24-byte digit buffer + the parsing state.
+ *
+ * Supported: %d %i %u %x %X %c %s %p %%, flags '-' '0' '+' ' ' '#',
+ * width and precision (digits or '*'), length modifiers hh h l ll z.
+ *
+ * Integers that fit in 32 bits are converted with 32-bit divides only;
+ * 64-bit values take one 64-bit divide per 9 digits above 2^32.
+ *
+ * %q prints a decimal fixed-point value: the argument is an int scaled
+ * by 10^precision (precision 0..9, default 0). Length modifiers apply
+ * as for %d: %.3q of 12345 prints "12.345", %.2lq of -5 prints "-0.05"
+ * and %.3llq takes an int64_t.
+ *
+ * Floating point (%f, %e, %g) is not supported; those specifiers print
+ * a literal '?'.
+ */
+
+#ifndef INC_FMT_H_
+#define INC_FMT_H_
+
+#include <stdint.h>
+#include <stdarg.h>
+
+#define FMT_CHUNK_SIZE  32u
+
+typedef void (*fmt_sink_t)(void *ctx, const char *data, uint32_t len);
+
+/* Returns the number of characters produced */
+uint32_t fmt_vformat(fmt_sink_t sink, void *ctx, const char *format, va_list ap);
+uint32_t fmt_format (fmt_sink_t sink, void *ctx, const char *format, ...);
+
+/* Bounded buffer, always NUL-terminated when size > 0; returns the untruncated length */
+uint32_t fmt_snprintf(char *buf, uint32_t size, const char *format, ...);
+
+#endif /* INC_FMT_H_ */
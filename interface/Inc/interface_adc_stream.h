@@ -0,0 +1,32 @@
+/**
+ * @file interface_adc_stream.h
+ * @brief Timer-paced ADC0 capture into a sample FIFO
+ *
+ * TIM3 interrupts at the requested rate; each interrupt collects the
+ * previous conversion of ADC1 CH1 (PA1) and starts the next one, so the
+ * ISR never waits on the converter. Samples are pushed into a
+ * single-producer/single-consumer FIFO drained from the main loop.
+ * Refuses to start while the control loop owns ADC1.
+ */
+
+#ifndef INC_INTERFACE_ADC_STREAM_H_
+#define INC_INTERFACE_ADC_STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADC_STREAM_FIFO_SIZE    512u        /* samples, power of two */
+#define ADC_STREAM_MIN_HZ       16u
+#define ADC_STREAM_MAX_HZ       10000u      /* ~60 us per conversion at 480 cycles */
+
+bool     adc_stream_start(uint32_t rate_hz);
+void     adc_stream_stop(void);
+bool     adc_stream_running(void);
+uint32_t adc_stream_rate(void);
+
+/* copies up to max samples out of the FIFO, returns the count */
+uint32_t adc_stream_read(uint16_t *out, uint32_t max);
+uint32_t adc_stream_pending(void);
+uint32_t adc_stream_overruns(void);     /* samples dropped on a full FIFO */
+
+#endif /* INC_INTERFACE_ADC_STREAM_H_ */
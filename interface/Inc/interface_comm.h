@@ -0,0 +1,36 @@
+/**
+ * @file interface_comm.h
+ * @brief Scatter-gather and ownership-transfer transmit for comm instances
+ *
+ * Extends comm_send() from interface.h. Segments are sent in order as
+ * one message without being gathered into a scratch buffer.
+ *
+ * Instances without a native sendv get one send() per non-empty segment.
+ * On byte streams (UART, CDC) that is the same message; on I2C each
+ * segment becomes its own transfer.
+ */
+
+#ifndef INC_INTERFACE_COMM_H_
+#define INC_INTERFACE_COMM_H_
+
+#include <stdint.h>
+
+typedef struct
+{
+    const uint8_t *base;
+    uint32_t       len;
+} comm_iovec_t;
+
+typedef void (*comm_release_t)(void *block);
+
+void comm_sendv(uint8_t comm_id, const comm_iovec_t *iov, uint8_t count);
+
+/*
+ * Sends len bytes of block and hands the block back through release()
+ * once the transfer has completed (e.g. pass the pool's free function).
+ * All current instances transmit synchronously, so release() runs before
+ * this returns; callers must not touch block after the call either way.
+ */
+void comm_send_owned(uint8_t comm_id, void *block, uint32_t len, comm_release_t release);
+
+#endif /* INC_INTERFACE_COMM_H_ */
@@ -0,0 +1,49 @@
+/**
+ * @file interface_control.h
+ * @brief Hard real-time control loop: ADC0 -> PID -> PWM0
+ *
+ * TIM4 interrupts at the loop rate. Each interrupt takes the ADC1 CH1
+ * conversion started by the previous one, runs the PID and writes the
+ * TIM2 CH1 compare register directly, then starts the next conversion.
+ * The loop owns ADC1 while running, so it cannot run together with
+ * the ADC stream. control_start() refuses while a trip is latched.
+ *
+ * Measurement is in ADC counts (0-4095), output in PWM0 compare counts.
+ */
+
+#ifndef INC_INTERFACE_CONTROL_H_
+#define INC_INTERFACE_CONTROL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "control_pid.h"
+
+#define CONTROL_MIN_HZ      100u
+#define CONTROL_MAX_HZ      20000u
+
+typedef struct
+{
+    uint32_t runs;
+    uint32_t missed;            /* ADC conversion not ready in time */
+    uint32_t exec_last_cyc;
+    uint32_t exec_worst_cyc;
+    uint32_t period_min_cyc;    /* ISR entry to ISR entry */
+    uint32_t period_max_cyc;
+    int32_t  last_meas;
+    int32_t  last_out;
+} control_stats_t;
+
+/* out_min/out_max of gains are clamped to the PWM0 range; stop restores the duty from before start */
+bool     control_start(uint32_t rate_hz, const pid_q16_t *gains, int32_t setpoint);
+void     control_stop(void);
+bool     control_running(void);
+uint32_t control_rate(void);
+
+/* safe from any task: one aligned 32-bit store */
+void     control_set_setpoint(int32_t setpoint);
+int32_t  control_setpoint(void);
+
+void     control_stats(control_stats_t *out);
+void     control_stats_reset(void);
+
+#endif /* INC_INTERFACE_CONTROL_H_ */
@@ -0,0 +1,60 @@
+/**
+ * @file interface_crc.h
+ * @brief CRC-32 service — STM32 CRC unit, DMA for large blocks, software fallback
+ *
+ * The algorithm is the one the F4 CRC unit implements: polynomial
+ * 0x04C11DB7, initial value 0xFFFFFFFF, no reflection, no final XOR.
+ * Data is consumed as little-endian 32-bit words, MSB first. So a byte
+ * buffer gives the same result as the unit fed with plain word loads.
+ * A trailing partial word is zero-padded by crc32_final().
+ *
+ * The streaming API carries up to 3 bytes between updates, so the result
+ * does not depend on how the data is split. Whole words go to the fastest
+ * available path: the CRC unit fed by DMA2 memory-to-memory for blocks of
+ * CRC_DMA_MIN_WORDS or more, the CPU feeding the unit for shorter ones,
+ * and the table-driven software loop on host builds (INTERFACE_HOST).
+ * All three paths are bit-compatible.
+ *
+ * The unit is one shared register, so contexts may interleave: each call
+ * resumes the unit from the context's own value. Main loop only — do not
+ * call from ISRs.
+ *
+ * Appending the final CRC as a little-endian word gives a residue of 0
+ * over data + CRC. tools/image_crc.py uses this to seal flash.bin.
+ */
+
+#ifndef INC_INTERFACE_CRC_H_
+#define INC_INTERFACE_CRC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define CRC32_INIT          0xFFFFFFFFu
+#define CRC32_POLY          0x04C11DB7u
+#define CRC_DMA_MIN_WORDS   64u         /* below this DMA setup costs more than it saves */
+
+typedef struct
+{
+    uint32_t crc;
+    uint32_t tail;          /* bytes not yet forming a whole word */
+    uint8_t  tail_len;
+} crc32_ctx_t;
+
+void     crc32_begin (crc32_ctx_t *ctx);
+void     crc32_update(crc32_ctx_t *ctx, const void *data, size_t len);
+uint32_t crc32_final (crc32_ctx_t *ctx);
+uint32_t crc32       (const void *data, size_t len);
+
+/* Whole words from a running value, fastest available path */
+uint32_t crc32_words   (uint32_t crc, const uint32_t *words, size_t count);
+uint32_t crc32_words_sw(uint32_t crc, const uint32_t *words, size_t count);
+
+#ifndef INTERFACE_HOST
+void     crc_init(void);
+
+/* Individual hardware paths, for benchmarks */
+uint32_t crc32_words_hw (uint32_t crc, const uint32_t *words, size_t count);
+uint32_t crc32_words_dma(uint32_t crc, const uint32_t *words, size_t count);
+#endif
+
+#endif /* INC_INTERFACE_CRC_H_ */
@@ -0,0 +1,30 @@
+/**
+ * @file interface_cycles.h
+ * @brief DWT cycle counter — timestamps for profiling and benchmarks
+ *
+ * The counter runs from reset once cycles_init() has been called and
+ * wraps every 2^32 core cycles (~268 s at 16 MHz). Differences computed
+ * with unsigned subtraction are wrap-safe for intervals shorter than that.
+ */
+
+#ifndef INC_INTERFACE_CYCLES_H_
+#define INC_INTERFACE_CYCLES_H_
+
+#include <stdint.h>
+
+#define CYCLES_DEFAULT_CORE_HZ  16000000u   /* HSI, no PLL */
+
+#define DWT_CYCCNT_REG  (*(volatile uint32_t *)0xE0001004UL)
+
+void     cycles_init(uint32_t core_hz);
+uint32_t cycles_core_hz(void);
+uint32_t cycles_to_us(uint32_t cycles);
+uint32_t cycles_to_ns(uint32_t cycles);
+
+/* forced even at -O0: FAST_CODE handlers must not call out to flash for this */
+static inline __attribute__((always_inline)) uint32_t cycles_now(void)
+{
+    return DWT_CYCCNT_REG;
+}
+
+#endif /* INC_INTERFACE_CYCLES_H_ */
@@ -7,6 +7,7 @@
 
 #define INTERFACE_PROTOCOL_UART2            0
 #define INTERFACE_PROTOCOL_I2C1             1
+#define INTERFACE_PROTOCOL_USB_CDC          2       // PA11/PA12 - OTG FS
 
 /************************************************************
 *                     IO INSTANCES                          *
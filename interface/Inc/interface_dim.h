@@ -0,0 +1,47 @@
+/**
+ * @file interface_dim.h
+ * @brief Bit-angle-modulation dimming for IO pins from one timer ISR
+ *
+ * An 8-bit level is shown as 8 bit-planes per frame; plane k lasts
+ * 2^k time units. TIM10 interrupts once per plane (8 times per frame)
+ * and writes one precomputed BSRR word per GPIO port, so the ISR cost
+ * depends on the number of ports, not the number of LEDs.
+ *
+ * While a pin is attached the dimmer owns it: IO_write()/led_turn_on()
+ * on that pin are overwritten at the next plane.
+ */
+
+#ifndef INC_INTERFACE_DIM_H_
+#define INC_INTERFACE_DIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DIM_BITS            8u
+#define DIM_MAX_LEDS        8u
+#define DIM_MAX_PORTS       3u
+#define DIM_DEFAULT_HZ      200u
+
+typedef struct
+{
+    uint32_t frame_hz;
+    uint32_t isr_count;
+    uint32_t isr_worst_cyc;
+    uint32_t isr_avg_cyc;
+    uint32_t load_ppm;          /* avg ISR cycles * ISRs per second / core clock */
+} dim_stats_t;
+
+bool dim_attach(uint8_t pin_id, bool inverted);
+void dim_detach(uint8_t pin_id);
+bool dim_owns(uint8_t pin_id);     /* other writers should leave the pin alone */
+
+/* level 0-255; with gamma enabled it is perceptual, otherwise duty */
+void dim_set(uint8_t pin_id, uint8_t level);
+void dim_set_gamma(uint8_t pin_id, bool enable);
+
+bool dim_start(uint32_t frame_hz);
+void dim_stop(void);
+bool dim_running(void);
+void dim_stats(dim_stats_t *out);
+
+#endif /* INC_INTERFACE_DIM_H_ */
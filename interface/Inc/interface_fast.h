@@ -0,0 +1,46 @@
+/**
+ * @file interface_fast.h
+ * @brief Execute-from-RAM placement for hot code and read-mostly tables
+ *
+ * Flash needs wait states once SYSCLK is above 30 MHz (1 WS up to 64 MHz,
+ * 2 up to 90, 3 up to 100 at 3.3 V). The ART accelerator hides most of
+ * them in straight-line loops, but not in the branchy code of ISRs and
+ * table dispatch after a cache miss. SRAM is zero-wait at any clock.
+ *
+ * FAST_CODE puts a function in .fast_code and FAST_DATA puts an object in
+ * .fast_data. app/fast_ram.ld collects both into one output section .fast.
+ * It runs from SRAM but is loaded from flash right after .data, and it
+ * also pulls in the ring buffer from the common library by object name.
+ * fast_copy_init() copies the load image down. main() calls it before
+ * anything else, because the vendor startup copies only .data.
+ *
+ * Calls between flash and .fast are out of BL range and go through a
+ * linker veneer (a few cycles). Callees that stay in flash still run at
+ * flash speed, so mark whole call chains, not single functions.
+ * `tools/map_report.py flash.map --output-section .fast` lists the result.
+ *
+ * FAST_DATA is for const lookup tables read on hot paths; writable data is
+ * in SRAM already. gcc rejects const and writable objects in one named
+ * section, so keep every FAST_DATA object const.
+ */
+
+#ifndef INC_INTERFACE_FAST_H_
+#define INC_INTERFACE_FAST_H_
+
+#include <stdint.h>
+
+#if defined(INTERFACE_HOST)
+#define FAST_CODE
+#define FAST_DATA
+#else
+#define FAST_CODE   __attribute__((section(".fast_code"), noinline))
+#define FAST_DATA   __attribute__((section(".fast_data")))
+#endif
+
+/* Copy .fast from its flash load image; before any FAST_CODE runs */
+void     fast_copy_init(void);
+
+uint32_t fast_size(void);           /* bytes of .fast, code and data */
+uint32_t fast_load_end(void);       /* flash address after the load image */
+
+#endif /* INC_INTERFACE_FAST_H_ */
@@ -0,0 +1,209 @@
+/**
+ * @file interface_hal.hpp
+ * @brief Compile-time HAL: Pin, PinGroup, PwmChannel, Uart
+ *
+ * Header-only counterpart of the interface dispatch tables. Everything
+ * is resolved at compile time: a Pin<GpioB, 3>::set() is one store to
+ * GPIOB->BSRR, with no table lookup, bounds check or init flag.
+ * Instances must already be configured (by the C API or the boot
+ * stages) before these are used; both APIs can be mixed freely.
+ *
+ * board::Io<INTERFACE_IO_n>, board::Pwm<INTERFACE_PWM_n> and
+ * board::Comm<INTERFACE_PROTOCOL_x> map the ids from interface_defines.h
+ * to their templates. board::Io expands the same pin list as
+ * s_pin_configs[] (interface_io_pins.h); the PWM/UART mapping mirrors
+ * their single instances.
+ *
+ * Members are always_inline: the firmware builds at -O0, where a plain
+ * inline member is still a call and the one-store claim above fails.
+ */
+
+#ifndef INC_INTERFACE_HAL_HPP_
+#define INC_INTERFACE_HAL_HPP_
+
+#include <stdint.h>
+#include "interface_defines.h"
+#include "interface_io_pins.h"
+#include "driver_gpio.h"
+#include "driver_timer.h"
+#include "driver_uart.h"
+
+#define HAL_INLINE  __attribute__((always_inline)) inline
+
+namespace hal {
+
+/* ------------------------------------------------------------------ */
+/*  Peripheral base addresses                                         */
+/* ------------------------------------------------------------------ */
+
+enum GpioPort : uintptr_t
+{
+    GpioA = 0x40020000u,
+    GpioB = 0x40020400u,
+    GpioC = 0x40020800u,
+};
+
+enum TimerBase : uintptr_t
+{
+    Tim2 = 0x40000000u,
+    Tim3 = 0x40000400u,
+    Tim4 = 0x40000800u,
+    Tim5 = 0x40000C00u,
+};
+
+enum UartBase : uintptr_t
+{
+    Usart2 = 0x40004400u,
+};
+
+/* ------------------------------------------------------------------ */
+/*  Pin                                                               */
+/* ------------------------------------------------------------------ */
+
+template <GpioPort Port, uint8_t N, bool Inverted = false>
+struct Pin
+{
+    static_assert(N < 16u, "GPIO pin number out of range");
+
+    static constexpr GpioPort port     = Port;
+    static constexpr uint32_t mask     = 1UL << N;
+    static constexpr uint32_t set_bits = Inverted ? (mask << 16) : mask;
+    static constexpr uint32_t clr_bits = Inverted ? mask : (mask << 16);
+
+    HAL_INLINE static GPIO_RegDef_t *regs() { return reinterpret_cast<GPIO_RegDef_t *>(Port); }
+
+    HAL_INLINE static void set()           { regs()->BSRR = set_bits; }
+    HAL_INLINE static void clear()         { regs()->BSRR = clr_bits; }
+    HAL_INLINE static void write(bool on)  { regs()->BSRR = on ? set_bits : clr_bits; }
+    HAL_INLINE static void toggle()        { regs()->ODR ^= mask; }
+    HAL_INLINE static bool read()          { return ((regs()->IDR & mask) != 0u) != Inverted; }
+};
+
+/* ------------------------------------------------------------------ */
+/*  PinGroup — one BSRR store for all pins (same port)               */
+/* ------------------------------------------------------------------ */
+
+template <typename... Pins>
+struct PinGroup;
+
+template <typename First, typename... Rest>
+struct PinGroup<First, Rest...>
+{
+    typedef PinGroup<Rest...> Tail;
+
+    static constexpr GpioPort port     = First::port;
+    static constexpr uint32_t set_bits = First::set_bits | Tail::set_bits;
+    static constexpr uint32_t clr_bits = First::clr_bits | Tail::clr_bits;
+
+    static_assert(sizeof...(Rest) == 0u || First::port == Tail::port,
+                  "PinGroup pins must share one GPIO port");
+
+    HAL_INLINE static GPIO_RegDef_t *regs() { return reinterpret_cast<GPIO_RegDef_t *>(port); }
+
+    HAL_INLINE static void set_all()   { regs()->BSRR = set_bits; }
+    HAL_INLINE static void clear_all() { regs()->BSRR = clr_bits; }
+
+    /* bit i of value drives the i-th pin of the group */
+    HAL_INLINE static void write(uint32_t value) { regs()->BSRR = bits(value); }
+
+    HAL_INLINE static uint32_t bits(uint32_t value)
+    {
+        return ((value & 1u) ? First::set_bits : First::clr_bits) | Tail::bits(value >> 1);
+    }
+};
+
+template <>
+struct PinGroup<>
+{
+    static constexpr GpioPort port     = GpioA;
+    static constexpr uint32_t set_bits = 0u;
+    static constexpr uint32_t clr_bits = 0u;
+
+    HAL_INLINE static uint32_t bits(uint32_t) { return 0u; }
+};
+
+/* ------------------------------------------------------------------ */
+/*  PwmChannel                                                        */
+/* ------------------------------------------------------------------ */
+
+template <TimerBase Tim, uint8_t Ch>
+struct PwmChannel
+{
+    static_assert(Ch >= 1u && Ch <= 4u, "timer channel must be 1-4");
+
+    HAL_INLINE static TIM_RegDef_t *regs() { return reinterpret_cast<TIM_RegDef_t *>(Tim); }
+
+    HAL_INLINE static volatile uint32_t &ccr()
+    {
+        return (Ch == 1u) ? regs()->CCR1 :
+               (Ch == 2u) ? regs()->CCR2 :
+               (Ch == 3u) ? regs()->CCR3 : regs()->CCR4;
+    }
+
+    HAL_INLINE static void     set_compare(uint32_t counts) { ccr() = counts; }
+    HAL_INLINE static uint32_t period()                     { return regs()->ARR + 1u; }
+
+    /* 0-1000 without float math */
+    HAL_INLINE static void set_permille(uint32_t permille)
+    {
+        ccr() = (period() * permille) / 1000u;
+    }
+};
+
+/* ------------------------------------------------------------------ */
+/*  Uart (polled TX)                                                  */
+/* ------------------------------------------------------------------ */
+
+template <UartBase Instance>
+struct Uart
+{
+    static constexpr uint32_t sr_txe  = 1u << 7;
+    static constexpr uint32_t sr_tc   = 1u << 6;
+    static constexpr uint32_t sr_rxne = 1u << 5;
+
+    HAL_INLINE static UART_RegDef_t *regs() { return reinterpret_cast<UART_RegDef_t *>(Instance); }
+
+    static void put(uint8_t byte)
+    {
+        while (!(regs()->SR & sr_txe)) {}
+        regs()->DR = byte;
+    }
+
+    static void write(const uint8_t *data, uint32_t len)
+    {
+        for (uint32_t i = 0u; i < len; i++) put(data[i]);
+        while (!(regs()->SR & sr_tc)) {}
+    }
+
+    /* RX is owned by the interrupt-driven ring buffer when comm_init() ran */
+    static bool readable() { return (regs()->SR & sr_rxne) != 0u; }
+};
+
+} /* namespace hal */
+
+/* ------------------------------------------------------------------ */
+/*  Board mapping from interface_defines.h                            */
+/* ------------------------------------------------------------------ */
+
+namespace board {
+
+template <uint8_t Id> struct Io;
+
+#define BOARD_IO_PIN(id, port, pin, mode, speed, otype, pupd) \
+    template <> struct Io<id> { typedef hal::Pin<hal::Gpio##port, pin> type; };
+
+INTERFACE_IO_PINS(BOARD_IO_PIN)
+
+#undef BOARD_IO_PIN
+
+template <uint8_t Id> struct Pwm;
+template <> struct Pwm<INTERFACE_PWM_0> { typedef hal::PwmChannel<hal::Tim2, 1> type; };   /* PA5 - TIM2 CH1 */
+
+template <uint8_t Id> struct Comm;
+template <> struct Comm<INTERFACE_PROTOCOL_UART2> { typedef hal::Uart<hal::Usart2> type; };
+
+} /* namespace board */
+
+#undef HAL_INLINE
+
+#endif /* INC_INTERFACE_HAL_HPP_ */
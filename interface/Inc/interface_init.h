@@ -0,0 +1,67 @@
+/**
+ * @file interface_init.h
+ * @brief Explicit bring-up and pre-initialised fast paths
+ *
+ * By default every interface call lazily initialises its instance on first
+ * use. When INTERFACE_PREINIT is defined (release builds), the application
+ * guarantees that every instance it uses is brought up during config_app(),
+ * so the per-call init checks compile away and the *_fast() entry points
+ * skip dispatch bounds checks as well.
+ *
+ * Without INTERFACE_PREINIT the *_fast() names map onto the checked API,
+ * so application code can use them unconditionally.
+ */
+
+#ifndef INC_INTERFACE_INIT_H_
+#define INC_INTERFACE_INIT_H_
+
+#include <stdint.h>
+#include "interface/interface.h"
+
+/* ------------------------------------------------------------------ */
+/*  Internal: per-call lazy init                                      */
+/* ------------------------------------------------------------------ */
+
+#if defined(INTERFACE_PREINIT)
+#define INTERFACE_LAZY_INIT(flag, init_fn)  ((void)0)
+#else
+#define INTERFACE_LAZY_INIT(flag, init_fn)  do { if (!(flag)) (init_fn)(); } while (0)
+#endif
+
+/* ------------------------------------------------------------------ */
+/*  Explicit init for modules without one in interface.h              */
+/* ------------------------------------------------------------------ */
+
+void timebase_init(void);
+
+/* ------------------------------------------------------------------ */
+/*  Fast paths — ids must be valid and already initialised            */
+/* ------------------------------------------------------------------ */
+
+#if defined(INTERFACE_PREINIT)
+
+void     IO_write_fast     (uint8_t pin_id, uint8_t value);
+void     IO_toggle_fast    (uint8_t pin_id);
+uint8_t  IO_read_fast      (uint8_t pin_id);
+uint16_t analog_read_fast  (uint8_t channel_id);
+void     PWM_set_duty_fast (uint8_t instance_id, float duty_percent);
+uint64_t timebase_get_fast (void);
+
+#else
+
+#define IO_write_fast(pin_id, value)            ((void)IO_write((pin_id), (value)))
+#define IO_toggle_fast(pin_id)                  ((void)IO_toggle((pin_id)))
+#define analog_read_fast(channel_id)            analog_read((channel_id))
+#define PWM_set_duty_fast(instance_id, duty)    PWM_set_duty((instance_id), (duty))
+#define timebase_get_fast()                     timebase_get()
+
+static inline uint8_t IO_read_fast(uint8_t pin_id)
+{
+    uint8_t value = 0u;
+    (void)IO_read(pin_id, &value);
+    return value;
+}
+
+#endif /* INTERFACE_PREINIT */
+
+#endif /* INC_INTERFACE_INIT_H_ */
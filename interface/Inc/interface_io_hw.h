@@ -0,0 +1,15 @@
+/**
+ * @file interface_io_hw.h
+ * @brief Port/pin lookup for interface modules that drive GPIO registers
+ */
+
+#ifndef INC_INTERFACE_IO_HW_H_
+#define INC_INTERFACE_IO_HW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driver_gpio.h"
+
+bool IO_get_hw(uint8_t pin_id, GPIO_RegDef_t **port, uint8_t *pin);
+
+#endif /* INC_INTERFACE_IO_HW_H_ */
@@ -0,0 +1,26 @@
+/**
+ * @file interface_io_pins.h
+ * @brief The IO pin list, shared by interface_io.c and interface_hal.hpp
+ *
+ * X-macro: each consumer defines X(id, port, pin, mode, speed, otype, pupd)
+ * and expands INTERFACE_IO_PINS(X). port is the GPIO letter, pin the
+ * number, so s_pin_configs[] pastes GPIOx / GPIO_PIN_NO_n and board::Io
+ * pastes hal::Gpiox. To add a pin, add a line here and its id to
+ * interface_defines.h.
+ */
+
+#ifndef INC_INTERFACE_IO_PINS_H_
+#define INC_INTERFACE_IO_PINS_H_
+
+#include "interface_defines.h"
+
+/*   id              port pin  mode           speed           otype            pupd         */
+#define INTERFACE_IO_PINS(X)                                                                   \
+    X(INTERFACE_IO_0, C, 13, GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD)  /* PC13 */ \
+    X(INTERFACE_IO_1, A, 5,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD)  /* PA5  */ \
+    X(INTERFACE_IO_2, B, 3,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD)  /* PB3  */ \
+    X(INTERFACE_IO_3, B, 4,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD)  /* PB4  */ \
+    X(INTERFACE_IO_4, B, 5,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD)  /* PB5  */ \
+    X(INTERFACE_IO_5, A, 0,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD)  /* PA0  */
+
+#endif /* INC_INTERFACE_IO_PINS_H_ */
@@ -0,0 +1,161 @@
+/**
+ * @file interface_irq.h
+ * @brief Critical sections, NVIC priority plan and ISR profiling
+ *
+ * Every interrupt the firmware enables has one row in the plan table in
+ * interface_irq.c. irq_plan_apply() sets the priority grouping and writes
+ * all rows into the NVIC once at boot, so modules only enable or disable
+ * their lines with interrupt_Config() and never pick a priority.
+ *
+ * Grouping is 2 bits preemption / 2 bits sub-priority (4 levels each).
+ * Lower numbers win. Sources at the same preempt level never nest; the
+ * sub-priority only orders them when both are pending.
+ *
+ * irq_save() raises BASEPRI to mask preempt levels 1-3. Level 0 (the
+ * trip ISRs) stays live, so no critical section delays a trip. State
+ * that a level-0 handler also touches needs irq_save_all() (PRIMASK).
+ * Keep those sections to a few loads and stores. Sections nest: BASEPRI
+ * is only ever raised by irq_save().
+ *
+ * Each handler brackets its body with irq_profile_enter()/irq_profile_exit().
+ * This records the handler duration in DWT cycles. Timer sources also pass
+ * their entry latency, derived from the counter value at entry: CNT counts
+ * up from 0 at the update event, so CNT * (PSC + 1) is the number of core
+ * cycles since the event fired. Other sources pass 0 (not measurable).
+ * CNT wraps every period and UIF cannot count, so a handler entered more
+ * than one period late reads as (lateness mod period). The control loop's
+ * period_max_cyc shows such a miss as a period of two or more ticks.
+ *
+ * Build with IRQ_PROFILE_MARKER to drive PA8 high while any profiled ISR
+ * runs, for a scope or logic analyser.
+ */
+
+#ifndef INC_INTERFACE_IRQ_H_
+#define INC_INTERFACE_IRQ_H_
+
+#include <stdint.h>
+#include "interface_cycles.h"
+
+/* BASEPRI for irq_save(): priority byte of preempt level 1 (see IRQ_PRIO_BYTE in interface_irq.c) */
+#define IRQ_BASEPRI_MASK    0x40u
+
+/* Forced: the build is -O0, and a call out of a FAST_CODE handler lands in flash */
+#define IRQ_INLINE  static inline __attribute__((always_inline))
+
+#if defined(INTERFACE_HOST)
+/* host builds are single-threaded */
+IRQ_INLINE uint32_t irq_save(void)                    { return 0u; }
+IRQ_INLINE void     irq_restore(uint32_t basepri)     { (void)basepri; }
+IRQ_INLINE uint32_t irq_save_all(void)                { return 0u; }
+IRQ_INLINE void     irq_restore_all(uint32_t primask) { (void)primask; }
+#else
+IRQ_INLINE uint32_t irq_save(void)
+{
+    uint32_t basepri;
+    __asm volatile ("mrs %0, basepri\n msr basepri_max, %1"
+                    : "=&r" (basepri) : "r" (IRQ_BASEPRI_MASK) : "memory");
+    return basepri;
+}
+
+IRQ_INLINE void irq_restore(uint32_t basepri)
+{
+    __asm volatile ("msr basepri, %0" :: "r" (basepri) : "memory");
+}
+
+IRQ_INLINE uint32_t irq_save_all(void)
+{
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+IRQ_INLINE void irq_restore_all(uint32_t primask)
+{
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+#endif
+
+/* ------------------------------------------------------------------ */
+/*  Priority plan                                                     */
+/* ------------------------------------------------------------------ */
+
+typedef enum
+{
+    IRQ_SRC_EXTI0 = 0,      /* comparator trip        */
+    IRQ_SRC_ADC,            /* analog watchdog trip   */
+    IRQ_SRC_TIM4,           /* control loop           */
+    IRQ_SRC_USART2,         /* console RX             */
+    IRQ_SRC_TIM3,           /* ADC stream pacing      */
+    IRQ_SRC_TIM10,          /* BAM dimmer             */
+    IRQ_SRC_OTG_FS,         /* USB CDC-ACM            */
+    IRQ_SRC_TIM5,           /* 64-bit us timebase     */
+    IRQ_SRC_SYSTICK,        /* ms ticks (not profiled) */
+    IRQ_SRC_COUNT
+} irq_source_t;
+
+typedef struct
+{
+    const char *name;
+    int16_t     irqn;       /* NVIC line, negative for core exceptions */
+    uint8_t     preempt;    /* 0..3 */
+    uint8_t     sub;        /* 0..3 */
+} irq_plan_entry_t;
+
+void                    irq_plan_apply(void);
+const irq_plan_entry_t *irq_plan_get(irq_source_t src);
+
+/* ------------------------------------------------------------------ */
+/*  Profiling                                                         */
+/* ------------------------------------------------------------------ */
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t dur_last_cyc;
+    uint32_t dur_worst_cyc;
+    uint32_t lat_worst_cyc;     /* 0 when the source has no latency stamp */
+} irq_profile_t;
+
+#ifdef IRQ_PROFILE_MARKER
+#define IRQ_MARKER_PIN      8u                                      /* PA8 */
+#define IRQ_MARKER_BSRR     (*(volatile uint32_t *)0x40020018UL)   /* GPIOA->BSRR */
+
+extern uint8_t irq_marker_depth;
+
+/*
+ * Nested handlers run to completion before the outer one resumes, so a
+ * plain depth counter stays balanced. The pin drops only when the
+ * outermost handler leaves.
+ */
+IRQ_INLINE void irq_marker_enter(void)
+{
+    if (irq_marker_depth++ == 0u) IRQ_MARKER_BSRR = (1u << IRQ_MARKER_PIN);
+}
+
+IRQ_INLINE void irq_marker_exit(void)
+{
+    if (--irq_marker_depth == 0u) IRQ_MARKER_BSRR = (1u << (IRQ_MARKER_PIN + 16u));
+}
+#else
+#define irq_marker_enter()  ((void)0)
+#define irq_marker_exit()   ((void)0)
+#endif
+
+IRQ_INLINE uint32_t irq_profile_enter(void)
+{
+    uint32_t entry = cycles_now();
+    irq_marker_enter();
+    return entry;
+}
+
+/* Core cycles since a timer's update event, from CNT read at entry */
+IRQ_INLINE uint32_t irq_timer_latency(uint32_t cnt, uint32_t psc)
+{
+    return cnt * (psc + 1u);
+}
+
+void irq_profile_exit(irq_source_t src, uint32_t entry, uint32_t latency_cyc);
+void irq_profile_get(irq_source_t src, irq_profile_t *out);
+void irq_profile_reset(void);
+
+#endif /* INC_INTERFACE_IRQ_H_ */
@@ -0,0 +1,94 @@
+/**
+ * @file interface_record.h
+ * @brief Record external inputs for deterministic replay
+ *
+ * While recording, the interface layer logs every UART RX byte, every
+ * level change seen by IO_read() and every analog_read() sample with a
+ * microsecond delta timestamp. The log is replayed on the host by
+ * record_replay_host.c against the same interface API.
+ *
+ * Levels are tracked from boot, so record_start() opens the log with the
+ * last level of every pin used so far. Replay then starts from the real
+ * idle state instead of all-low (the active-low button on PA0 would
+ * otherwise read pressed until its first edge).
+ *
+ * Event encoding:
+ *
+ *   tag (type << 4 | channel) | varint dt_us | payload
+ *
+ *   RECORD_UART_RX   payload: 1 byte
+ *   RECORD_GPIO_LOW  payload: none
+ *   RECORD_GPIO_HIGH payload: none
+ *   RECORD_ADC       payload: u16 little endian
+ *
+ * Samples from the ADC stream (interface_adc_stream.h) are not recorded.
+ */
+
+#ifndef INC_INTERFACE_RECORD_H_
+#define INC_INTERFACE_RECORD_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RECORD_BUFFER_SIZE      4096u
+#define RECORD_EVENT_MAX_SIZE   8u
+
+typedef enum
+{
+    RECORD_UART_RX   = 1,
+    RECORD_GPIO_LOW  = 2,
+    RECORD_GPIO_HIGH = 3,
+    RECORD_ADC       = 4,
+} record_type_t;
+
+typedef struct
+{
+    uint8_t  type;
+    uint8_t  channel;
+    uint32_t dt_us;
+    uint16_t value;
+} record_event_t;
+
+/* recorder (target) */
+void           record_start(void);
+void           record_stop(void);
+bool           record_active(void);
+const uint8_t *record_data(uint32_t *len);
+uint32_t       record_dropped(void);
+
+void           record_uart_rx(uint8_t channel, uint8_t byte);
+void           record_gpio(uint8_t pin_id, uint8_t level);
+void           record_adc(uint8_t channel, uint16_t sample);
+
+/* format (host-safe); returns bytes consumed, 0 at end or on a bad event */
+uint32_t       record_encode(uint8_t *out, const record_event_t *ev);
+uint32_t       record_decode(const uint8_t *in, uint32_t len, record_event_t *ev);
+
+#if defined(INTERFACE_HOST)
+
+/*
+ * Replay (record_replay_host.c): implements the interface.h API on the
+ * host and drives it from a recorded log in virtual time. step() is the
+ * super-loop body; it runs once per event and every idle_step_us between
+ * events so ticker tasks keep their cadence.
+ */
+
+typedef struct
+{
+    uint32_t events;
+    uint32_t steps;
+    uint64_t span_us;           /* virtual time covered by the log */
+    uint64_t busy_ns;           /* host time spent in step() for events */
+    uint32_t worst_ns;
+    uint8_t  worst_type;
+    uint32_t worst_budget_ppm;  /* step time / gap to next event */
+    uint32_t tx_bytes;
+} replay_report_t;
+
+void replay_load(const uint8_t *log, uint32_t len);
+bool replay_run(void (*step)(void), uint32_t idle_step_us, replay_report_t *report);
+void replay_echo_tx(bool enable);   /* copy comm_send() output to stdout */
+
+#endif /* INTERFACE_HOST */
+
+#endif /* INC_INTERFACE_RECORD_H_ */
@@ -0,0 +1,44 @@
+/**
+ * @file interface_timebase_us.h
+ * @brief 64-bit microsecond timebase
+ *
+ * TIM5 (32-bit) free-runs at 1 MHz; its update interrupt extends it with
+ * a 32-bit overflow count. Readers use a sequence counter, so a read is
+ * never torn by the overflow ISR and never blocks interrupts.
+ *
+ * timebase_us_get() and the wall-clock calls are thread context only.
+ * TIM5 has the lowest priority, so any other ISR can preempt its update
+ * and would then spin on the odd sequence count forever; debug builds
+ * trap such a call. ISRs use timebase_us_get32(), a single CNT read.
+ *
+ * The calendar helpers count microseconds since 2000-01-01 00:00:00
+ * (RTC year 0). A host backend (timebase_us_host.c) drives the same API
+ * from a virtual clock for unit tests.
+ */
+
+#ifndef INC_INTERFACE_TIMEBASE_US_H_
+#define INC_INTERFACE_TIMEBASE_US_H_
+
+#include <stdint.h>
+#include "bsp/rtc.h"
+
+#define TIMEBASE_US_PER_SEC     1000000ULL
+
+void     timebase_us_init(void);
+uint64_t timebase_us_get(void);
+uint32_t timebase_us_get32(void);   /* low word only, wraps every ~71 min; ISR-safe */
+
+/* wall clock = timebase_us_get() + offset captured at sync */
+void     timebase_us_sync(const RTC_DateTime_t *now);
+void     timebase_us_now(RTC_DateTime_t *out);
+
+/* pure conversions, host-safe */
+uint64_t timebase_us_from_datetime(const RTC_DateTime_t *dt);
+void     timebase_us_to_datetime(uint64_t us, RTC_DateTime_t *out);
+
+#if defined(INTERFACE_HOST)
+void     timebase_us_host_set(uint64_t us);
+void     timebase_us_host_advance(uint64_t us);
+#endif
+
+#endif /* INC_INTERFACE_TIMEBASE_US_H_ */
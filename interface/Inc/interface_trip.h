@@ -0,0 +1,61 @@
+/**
+ * @file interface_trip.h
+ * @brief Fast overcurrent trip for PWM0 (PA5, TIM2 CH1)
+ *
+ * Two independent trip paths force the output off without waiting for
+ * the main loop:
+ *
+ *  - ADC analog watchdog on ADC1 CH1: any conversion above the threshold
+ *    raises the ADC interrupt, which forces OC1 inactive. TIM2's update
+ *    starts an injected CH1 conversion every PWM period, so the watchdog
+ *    covers PWM0 even when nothing else converts CH1.
+ *
+ *  - External comparator on TIM2_ETR (PA0, active low): TIM2 has no
+ *    break input, so ETR drives OCREF clear. The output drops in
+ *    hardware within a few timer clocks, and EXTI0 latches it off.
+ *
+ * A trip stays latched until trip_rearm(). trip_take() reports each trip
+ * once, so it can be polled from a fault_config_t detect() callback and
+ * trip_rearm() called from on_recover().
+ *
+ * PWM0 and ADC0 init only once, so later PWM_init()/analog_init() calls
+ * keep the trip bits. After a deinit and re-init, trip_reapply() restores
+ * OC1CE, the ETR filter, the watchdog and a latched forced-inactive
+ * output. The control loop does not start while a trip is latched; the
+ * ADC stream only reads CH1 and keeps running.
+ */
+
+#ifndef INC_INTERFACE_TRIP_H_
+#define INC_INTERFACE_TRIP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum
+{
+    TRIP_SRC_NONE       = 0,
+    TRIP_SRC_ADC_AWD    = 1,
+    TRIP_SRC_COMPARATOR = 2,
+} trip_source_t;
+
+typedef struct
+{
+    uint32_t      count;
+    trip_source_t last_source;
+    uint32_t      react_last_cyc;   /* ISR entry -> output forced off */
+    uint32_t      react_worst_cyc;
+    uint32_t      post_last_cyc;    /* output forced off -> trip_take() */
+    uint32_t      post_worst_cyc;
+} trip_stats_t;
+
+#define TRIP_ADC_DISABLED   0xFFFFu
+
+/* adc_threshold in counts (TRIP_ADC_DISABLED to skip the watchdog) */
+void trip_init(uint16_t adc_threshold, bool use_comparator);
+bool trip_take(trip_source_t *source);
+bool trip_latched(void);
+void trip_rearm(void);
+void trip_reapply(void);        /* after any PWM0 / ADC1 re-init */
+void trip_stats(trip_stats_t *out);
+
+#endif /* INC_INTERFACE_TRIP_H_ */
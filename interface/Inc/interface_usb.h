@@ -0,0 +1,104 @@
+/**
+ * @file interface_usb.h
+ * @brief USB CDC-ACM comm instance (INTERFACE_PROTOCOL_USB_CDC)
+ *
+ * A full-speed device with one CDC-ACM function on the OTG FS core
+ * (PA11/PA12, 48 MHz from the PLL on the 25 MHz HSE). It is the third
+ * entry of the comm table, so comm_send()/comm_receive(), uprint_setup()
+ * and cli_setup() run over it unchanged.
+ *
+ * Both bulk endpoints are double-buffered in SRAM with two packet buffers
+ * each. On IN, the application fills one buffer while the other drains
+ * through the TX FIFO. A send to an idle endpoint goes out at once, and
+ * later writes coalesce into the next packet. On OUT, the controller
+ * writes the next packet straight into the free buffer. When both are
+ * full the endpoint stays disarmed, so the host is NAKed instead of
+ * data being dropped.
+ *
+ * With no host (not configured, suspended or DTR low) sends are
+ * discarded, so a console on USB never blocks the main loop. A send that
+ * finds both IN buffers busy waits at most USB_CDC_TX_TIMEOUT_US. After
+ * a timeout sends are dropped at once until the host takes a packet.
+ * CLEAR_FEATURE(ENDPOINT_HALT) clears the stall and resets the toggle.
+ *
+ * If the 48 MHz clock does not come up (no HSE) or the core does not leave
+ * reset, init gives up within a bounded time. usb_cdc_init_ok() then
+ * reports false and every send is dropped.
+ *
+ * Host builds (INTERFACE_HOST) replace the controller with an endpoint
+ * FIFO model driven by the usb_sim_* functions below; see tools/usb_sim.
+ */
+
+#ifndef INC_INTERFACE_USB_H_
+#define INC_INTERFACE_USB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "interface_comm.h"
+
+#define USB_CDC_PACKET          64u         /* bulk max packet size */
+#define USB_CDC_TX_TIMEOUT_US   20000u
+
+#define USB_CDC_EP_DATA_OUT     0x01u
+#define USB_CDC_EP_DATA_IN      0x81u
+#define USB_CDC_EP_NOTIFY       0x82u
+
+typedef struct
+{
+    uint32_t baud;
+    uint8_t  stop_bits;         /* 0 = 1, 1 = 1.5, 2 = 2 */
+    uint8_t  parity;
+    uint8_t  data_bits;
+} usb_cdc_line_coding_t;
+
+typedef struct
+{
+    uint32_t tx_bytes;
+    uint32_t tx_packets;
+    uint32_t tx_dropped;        /* bytes discarded: no host or timeout */
+    uint32_t rx_bytes;
+    uint32_t rx_packets;
+    uint32_t rx_naks;           /* OUT packets held off: both buffers full */
+    uint32_t resets;
+} usb_cdc_stats_t;
+
+bool usb_cdc_init_ok(void);         /* false: no HSE/PLL or OTG core reset timed out */
+bool usb_cdc_configured(void);
+bool usb_cdc_dtr(void);
+void usb_cdc_line_coding(usb_cdc_line_coding_t *out);
+void usb_cdc_stats(usb_cdc_stats_t *out);
+
+/* comm table entry */
+void    usb_cdc_protocol_init          (void);
+void    usb_cdc_protocol_send          (uint8_t *data, uint32_t len);
+void    usb_cdc_protocol_sendv         (const comm_iovec_t *iov, uint8_t count);
+uint8_t usb_cdc_protocol_receive       (uint8_t *buffer, uint32_t len);
+uint8_t usb_cdc_protocol_data_available(void);
+
+#if defined(INTERFACE_HOST)
+
+/*
+ * Host-side endpoint FIFO model. Each IN endpoint queues up to
+ * USB_SIM_IN_DEPTH packets written by the device. Each OUT endpoint
+ * accepts a packet only while the device has a buffer armed.
+ * Every packet moved advances the virtual timebase by its full-speed
+ * bus time, so throughput can be measured in bus time.
+ */
+#define USB_SIM_IN_DEPTH    4u
+#define USB_SIM_NAK         (-1)
+#define USB_SIM_STALL       (-2)
+
+void    usb_sim_attach(void);           /* bus reset + enumeration-ready */
+int     usb_sim_setup(const uint8_t setup[8]);
+int     usb_sim_out(uint8_t ep_num, const uint8_t *data, uint16_t len);
+int     usb_sim_in(uint8_t ep_num, uint8_t *buf, uint16_t cap);
+uint8_t usb_sim_address(void);
+void    usb_sim_suspend(bool suspended);
+
+/* consume bulk IN packets inside usb_hw_poll(), as a host reading continuously would */
+typedef void (*usb_sim_sink_t)(const uint8_t *data, uint16_t len);
+void    usb_sim_set_in_sink(uint8_t ep_num, usb_sim_sink_t sink);
+
+#endif /* INTERFACE_HOST */
+
+#endif /* INC_INTERFACE_USB_H_ */
@@ -0,0 +1,19 @@
+/**
+ * @file interface_watchdog.h
+ * @brief Independent watchdog (IWDG, clocked from the ~32 kHz LSI)
+ *
+ * Once started the IWDG cannot be stopped until the next reset.
+ */
+
+#ifndef INC_INTERFACE_WATCHDOG_H_
+#define INC_INTERFACE_WATCHDOG_H_
+
+#include <stdint.h>
+
+#define WATCHDOG_MAX_TIMEOUT_MS     32000u
+
+/* returns the timeout actually programmed, after prescaler rounding */
+uint32_t watchdog_init(uint32_t timeout_ms);
+void     watchdog_feed(void);
+
+#endif /* INC_INTERFACE_WATCHDOG_H_ */
@@ -0,0 +1,46 @@
+/**
+ * @file usb_hw.h
+ * @brief Port between the USB device core (usb_cdc.c) and the controller
+ *
+ * usb_otg_fs.c implements it on the F411 OTG FS core. usb_hw_host.c
+ * implements it on host builds as an endpoint FIFO model (interface_usb.h).
+ *
+ * Endpoint addresses use the USB convention: bit 7 set for IN.
+ * Every transfer is a single packet of at most the endpoint's max packet
+ * size. The port moves it straight between the caller's buffer and the
+ * controller FIFO, so there is no staging copy. OUT buffers must be
+ * 4-byte aligned and rounded up to a whole word.
+ */
+
+#ifndef INC_USB_HW_H_
+#define INC_USB_HW_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define USB_EP_IN           0x80u
+#define USB_EP_NUM(addr)    ((uint8_t)((addr) & 0x0Fu))
+
+#define USB_EP_TYPE_CONTROL 0u
+#define USB_EP_TYPE_BULK    2u
+#define USB_EP_TYPE_INTR    3u
+
+/* Controller — called by the device core */
+bool     usb_hw_init(void);     /* false: no 48 MHz clock or core stuck in reset */
+void     usb_hw_set_address(uint8_t address);
+void     usb_hw_ep_open(uint8_t ep_addr, uint8_t type, uint16_t max_packet);
+void     usb_hw_ep_stall(uint8_t ep_addr);
+void     usb_hw_ep_clear_stall(uint8_t ep_addr);     /* also resets the data toggle to DATA0 */
+void     usb_hw_ep_write(uint8_t ep_addr, const uint8_t *data, uint16_t len);
+void     usb_hw_ep_read_arm(uint8_t ep_addr, uint8_t *buf, uint16_t len);
+uint32_t usb_hw_device_id(void);
+void     usb_hw_poll(void);     /* busy-wait hook; the host model moves packets here */
+
+/* Events — called by the port, from OTG_FS_IRQHandler on the target */
+void usb_dev_on_reset(void);
+void usb_dev_on_suspend(bool suspended);
+void usb_dev_on_setup(const uint8_t setup[8]);
+void usb_dev_on_out(uint8_t ep_num, uint16_t len);
+void usb_dev_on_in_done(uint8_t ep_num);
+
+#endif /* INC_USB_HW_H_ */
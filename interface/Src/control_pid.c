@@ -0,0 +1,41 @@
+#include "control_pid.h"
+
+void pid_q16_reset(pid_q16_t *pid, int32_t meas)
+{
+    pid->integ     = 0;
+    pid->prev_meas = meas;
+}
+
+int32_t pid_q16_update(pid_q16_t *pid, int32_t setpoint, int32_t meas)
+{
+    int32_t err = setpoint - meas;
+
+    int64_t p = (int64_t)pid->kp * err;
+    int64_t d = -(int64_t)pid->kd * (meas - pid->prev_meas);
+    pid->prev_meas = meas;
+
+    int64_t lo = (int64_t)pid->out_min * PID_Q16_ONE;
+    int64_t hi = (int64_t)pid->out_max * PID_Q16_ONE;
+
+    int64_t integ = pid->integ + (int64_t)pid->ki * err;
+    if (integ > hi) integ = hi;
+    if (integ < lo) integ = lo;
+
+    int64_t out = p + integ + d;
+
+    /* conditional integration: keep the old integrator if it would wind further */
+    if ((out > hi && err > 0) || (out < lo && err < 0))
+    {
+        out = p + pid->integ + d;
+    }
+    else
+    {
+        pid->integ = integ;
+    }
+
+    if (out > hi) out = hi;
+    if (out < lo) out = lo;
+
+    /* round to nearest; a shift, not a 64-bit library divide, in the ISR */
+    return (int32_t)((out + PID_Q16_ONE / 2) >> 16);
+}
@@ -0,0 +1,14 @@
+/**
+ * @file crc32_host.c
+ * @brief Host backend for interface_crc.h — software only
+ *
+ * Built into interface_host (BUILD_TESTS) with INTERFACE_HOST defined.
+ * Results match the CRC unit bit for bit.
+ */
+
+#include "interface_crc.h"
+
+uint32_t crc32_words(uint32_t crc, const uint32_t *words, size_t count)
+{
+    return crc32_words_sw(crc, words, count);
+}
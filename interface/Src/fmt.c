@@ -0,0 +1,415 @@
+#include "fmt.h"
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define FL_LEFT     (1u << 0)
+#define FL_ZERO     (1u << 1)
+#define FL_PLUS     (1u << 2)
+#define FL_SPACE    (1u << 3)
+#define FL_ALT      (1u << 4)
+#define FL_PREC     (1u << 5)
+
+#define LEN_INT     0u
+#define LEN_LONG    1u
+#define LEN_LLONG   2u
+#define LEN_SHORT   3u
+#define LEN_CHAR    4u
+
+#define DIGITS_MAX          24u     /* 20 decimal digits for 2^64 */
+#define FIXED_MAX_DECIMALS  9u
+
+typedef struct
+{
+    fmt_sink_t sink;
+    void      *ctx;
+    uint32_t   used;
+    uint32_t   total;
+    char       chunk[FMT_CHUNK_SIZE];
+} fmt_out_t;
+
+typedef struct
+{
+    uint8_t  flags;
+    uint8_t  length;            /* LEN_* */
+    uint32_t width;
+    uint32_t prec;
+} fmt_spec_t;
+
+/* ------------------------------------------------------------------ */
+/*  Output                                                            */
+/* ------------------------------------------------------------------ */
+
+static void out_flush(fmt_out_t *o)
+{
+    if (o->used != 0u)
+    {
+        o->sink(o->ctx, o->chunk, o->used);
+        o->used = 0u;
+    }
+}
+
+static void out_char(fmt_out_t *o, char c)
+{
+    if (o->used == FMT_CHUNK_SIZE) out_flush(o);
+    o->chunk[o->used++] = c;
+    o->total++;
+}
+
+static void out_repeat(fmt_out_t *o, char c, uint32_t n)
+{
+    while (n--) out_char(o, c);
+}
+
+static void out_mem(fmt_out_t *o, const char *s, uint32_t n)
+{
+    while (n--) out_char(o, *s++);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Conversions — digits are written backwards from end               */
+/* ------------------------------------------------------------------ */
+
+static char *dec32(char *p, uint32_t v)
+{
+    do { *--p = (char)('0' + v % 10u); v /= 10u; } while (v != 0u);
+    return p;
+}
+
+static char *dec64(char *p, uint64_t v)
+{
+    while (v > 0xFFFFFFFFull)
+    {
+        uint64_t q   = v / 1000000000u;
+        uint32_t low = (uint32_t)(v - q * 1000000000u);
+        for (uint8_t i = 0u; i < 9u; i++)
+        {
+            *--p = (char)('0' + low % 10u);
+            low /= 10u;
+        }
+        v = q;
+    }
+    return dec32(p, (uint32_t)v);
+}
+
+static char *hex64(char *p, uint64_t v, bool upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    do { *--p = digits[v & 0xFu]; v >>= 4; } while (v != 0u);
+    return p;
+}
+
+/*
+ * Shared tail of every numeric conversion: sign/prefix, precision zeros,
+ * digits (with an optional '.' before the last `point` of them) and width
+ * padding on either side.
+ */
+static void emit_number(fmt_out_t *o, const fmt_spec_t *s, const char *prefix,
+                        const char *digits, uint32_t ndigits, uint32_t point)
+{
+    uint32_t nprefix = 0u;
+    while (prefix[nprefix] != '\0') nprefix++;
+
+    uint32_t zeros = 0u;
+    if ((s->flags & FL_PREC) && point == 0u && s->prec > ndigits) zeros = s->prec - ndigits;
+
+    uint32_t body = nprefix + zeros + ndigits + (point != 0u ? 1u : 0u);
+    uint32_t pad  = (s->width > body) ? s->width - body : 0u;
+
+    bool zero_pad = (s->flags & FL_ZERO) && !(s->flags & FL_LEFT) &&
+                    !((s->flags & FL_PREC) && point == 0u);
+
+    if (!(s->flags & FL_LEFT) && !zero_pad) out_repeat(o, ' ', pad);
+    out_mem(o, prefix, nprefix);
+    if (zero_pad) out_repeat(o, '0', pad);
+    out_repeat(o, '0', zeros);
+
+    if (point != 0u)
+    {
+        out_mem(o, digits, ndigits - point);
+        out_char(o, '.');
+        out_mem(o, digits + ndigits - point, point);
+    }
+    else
+    {
+        out_mem(o, digits, ndigits);
+    }
+
+    if (s->flags & FL_LEFT) out_repeat(o, ' ', pad);
+}
+
+static const char *sign_prefix(const fmt_spec_t *s, bool negative)
+{
+    if (negative)              return "-";
+    if (s->flags & FL_PLUS)    return "+";
+    if (s->flags & FL_SPACE)   return " ";
+    return "";
+}
+
+static void emit_string(fmt_out_t *o, const fmt_spec_t *s, const char *str)
+{
+    if (str == NULL) str = "(null)";
+
+    uint32_t len = 0u;
+    while (str[len] != '\0' && (!(s->flags & FL_PREC) || len < s->prec)) len++;
+
+    uint32_t pad = (s->width > len) ? s->width - len : 0u;
+    if (!(s->flags & FL_LEFT)) out_repeat(o, ' ', pad);
+    out_mem(o, str, len);
+    if (s->flags & FL_LEFT) out_repeat(o, ' ', pad);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Argument fetch                                                    */
+/* ------------------------------------------------------------------ */
+
+static int64_t arg_signed(va_list *ap, uint8_t length)
+{
+    switch (length)
+    {
+        case LEN_LLONG: return (int64_t)va_arg(*ap, long long);
+        case LEN_LONG:  return (int64_t)va_arg(*ap, long);
+        case LEN_SHORT: return (int64_t)(short)va_arg(*ap, int);
+        case LEN_CHAR:  return (int64_t)(signed char)va_arg(*ap, int);
+        default:        return (int64_t)va_arg(*ap, int);
+    }
+}
+
+static uint64_t arg_unsigned(va_list *ap, uint8_t length)
+{
+    switch (length)
+    {
+        case LEN_LLONG: return (uint64_t)va_arg(*ap, unsigned long long);
+        case LEN_LONG:  return (uint64_t)va_arg(*ap, unsigned long);
+        case LEN_SHORT: return (uint64_t)(unsigned short)va_arg(*ap, unsigned int);
+        case LEN_CHAR:  return (uint64_t)(unsigned char)va_arg(*ap, unsigned int);
+        default:        return (uint64_t)va_arg(*ap, unsigned int);
+    }
+}
+
+static uint32_t parse_uint(const char **p)
+{
+    uint32_t v = 0u;
+    while (**p >= '0' && **p <= '9')
+    {
+        v = v * 10u + (uint32_t)(**p - '0');
+        (*p)++;
+    }
+    return v;
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+uint32_t fmt_vformat(fmt_sink_t sink, void *ctx, const char *format, va_list ap_in)
+{
+    fmt_out_t o;
+    o.sink  = sink;
+    o.ctx   = ctx;
+    o.used  = 0u;
+    o.total = 0u;
+
+    if (sink == NULL || format == NULL) return 0u;
+
+    va_list ap;
+    va_copy(ap, ap_in);
+
+    char digits[DIGITS_MAX];
+    char *const end = digits + DIGITS_MAX;
+
+    for (const char *p = format; *p != '\0'; p++)
+    {
+        if (*p != '%')
+        {
+            out_char(&o, *p);
+            continue;
+        }
+
+        fmt_spec_t s = {0};
+
+        /* flags */
+        for (bool more = true; more; )
+        {
+            switch (*++p)
+            {
+                case '-': s.flags |= FL_LEFT;  break;
+                case '0': s.flags |= FL_ZERO;  break;
+                case '+': s.flags |= FL_PLUS;  break;
+                case ' ': s.flags |= FL_SPACE; break;
+                case '#': s.flags |= FL_ALT;   break;
+                default:  more = false;        break;
+            }
+        }
+
+        /* width */
+        if (*p == '*')
+        {
+            int w = va_arg(ap, int);
+            if (w < 0) { s.flags |= FL_LEFT; w = -w; }
+            s.width = (uint32_t)w;
+            p++;
+        }
+        else
+        {
+            s.width = parse_uint(&p);
+        }
+
+        /* precision */
+        if (*p == '.')
+        {
+            s.flags |= FL_PREC;
+            p++;
+            if (*p == '*')
+            {
+                int pr = va_arg(ap, int);
+                if (pr < 0) s.flags &= (uint8_t)~FL_PREC;
+                else        s.prec = (uint32_t)pr;
+                p++;
+            }
+            else
+            {
+                s.prec = parse_uint(&p);
+            }
+        }
+
+        /* length */
+        switch (*p)
+        {
+            case 'h':
+                p++;
+                s.length = LEN_SHORT;
+                if (*p == 'h') { p++; s.length = LEN_CHAR; }
+                break;
+            case 'l':
+                p++;
+                s.length = LEN_LONG;
+                if (*p == 'l') { p++; s.length = LEN_LLONG; }
+                break;
+            case 'z':
+                p++;
+                s.length = (sizeof(size_t) > sizeof(long)) ? LEN_LLONG : LEN_LONG;
+                break;
+            default:
+                break;
+        }
+
+        switch (*p)
+        {
+            case 'd':
+            case 'i':
+            {
+                int64_t  v   = arg_signed(&ap, s.length);
+                uint64_t mag = (v < 0) ? (uint64_t)0u - (uint64_t)v : (uint64_t)v;
+                char    *d   = dec64(end, mag);
+                if ((s.flags & FL_PREC) && s.prec == 0u && mag == 0u) d = end;
+                emit_number(&o, &s, sign_prefix(&s, v < 0), d, (uint32_t)(end - d), 0u);
+                break;
+            }
+            case 'u':
+            {
+                uint64_t v = arg_unsigned(&ap, s.length);
+                char    *d = dec64(end, v);
+                if ((s.flags & FL_PREC) && s.prec == 0u && v == 0u) d = end;
+                emit_number(&o, &s, "", d, (uint32_t)(end - d), 0u);
+                break;
+            }
+            case 'x':
+            case 'X':
+            {
+                uint64_t v = arg_unsigned(&ap, s.length);
+                char    *d = hex64(end, v, *p == 'X');
+                if ((s.flags & FL_PREC) && s.prec == 0u && v == 0u) d = end;
+                const char *prefix = ((s.flags & FL_ALT) && v != 0u) ? ((*p == 'X') ? "0X" : "0x") : "";
+                emit_number(&o, &s, prefix, d, (uint32_t)(end - d), 0u);
+                break;
+            }
+            case 'p':
+            {
+                uintptr_t v = (uintptr_t)va_arg(ap, void *);
+                char     *d = hex64(end, (uint64_t)v, false);
+                s.flags &= (uint8_t)~FL_PREC;
+                emit_number(&o, &s, "0x", d, (uint32_t)(end - d), 0u);
+                break;
+            }
+            case 'q':
+            {
+                int64_t  v     = arg_signed(&ap, s.length);
+                uint64_t mag   = (v < 0) ? (uint64_t)0u - (uint64_t)v : (uint64_t)v;
+                uint32_t point = (s.prec > FIXED_MAX_DECIMALS) ? FIXED_MAX_DECIMALS : s.prec;
+                char    *d     = dec64(end, mag);
+                while ((uint32_t)(end - d) < point + 1u) *--d = '0';
+                emit_number(&o, &s, sign_prefix(&s, v < 0), d, (uint32_t)(end - d), point);
+                break;
+            }
+            case 'c':
+            {
+                char c = (char)va_arg(ap, int);
+                uint32_t pad = (s.width > 1u) ? s.width - 1u : 0u;
+                if (!(s.flags & FL_LEFT)) out_repeat(&o, ' ', pad);
+                out_char(&o, c);
+                if (s.flags & FL_LEFT) out_repeat(&o, ' ', pad);
+                break;
+            }
+            case 's':
+                emit_string(&o, &s, va_arg(ap, const char *));
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+                (void)va_arg(ap, double);
+                out_char(&o, '?');
+                break;
+            case '%':
+                out_char(&o, '%');
+                break;
+            case '\0':
+                p--;                        /* lone '%' at the end */
+                break;
+            default:
+                out_char(&o, '%');
+                out_char(&o, *p);
+                break;
+        }
+    }
+
+    va_end(ap);
+    out_flush(&o);
+    return o.total;
+}
+
+uint32_t fmt_format(fmt_sink_t sink, void *ctx, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    uint32_t n = fmt_vformat(sink, ctx, format, ap);
+    va_end(ap);
+    return n;
+}
+
+typedef struct
+{
+    char    *buf;
+    uint32_t size;
+    uint32_t pos;
+} fmt_buf_t;
+
+static void buf_sink(void *ctx, const char *data, uint32_t len)
+{
+    fmt_buf_t *b = (fmt_buf_t *)ctx;
+    while (len-- && b->pos + 1u < b->size)
+    {
+        b->buf[b->pos++] = *data++;
+    }
+}
+
+uint32_t fmt_snprintf(char *buf, uint32_t size, const char *format, ...)
+{
+    fmt_buf_t b = { buf, (buf != NULL) ? size : 0u, 0u };
+
+    va_list ap;
+    va_start(ap, format);
+    uint32_t n = fmt_vformat(buf_sink, &b, format, ap);
+    va_end(ap);
+
+    if (b.size != 0u) buf[b.pos] = '\0';
+    return n;
+}
@@ -0,0 +1,156 @@
+#include "interface_adc_stream.h"
+#include "interface/interface.h"
+#include "interface_defines.h"
+#include "interface_cycles.h"
+#include "interface_irq.h"
+#include "interface_control.h"
+#include "interface_trip.h"
+#include "driver_adc.h"
+#include "driver_timer.h"
+#include "driver_interrupt.h"
+
+/* ------------------------------------------------------------------ */
+/*  Registers                                                         */
+/* ------------------------------------------------------------------ */
+
+#define TIM_CR1_CEN         (1u << 0)
+#define TIM_DIER_UIE        (1u << 0)
+#define TIM_SR_UIF          (1u << 0)
+#define TIM_EGR_UG          (1u << 0)
+
+#define ADC_SR_EOC          (1u << 1)
+#define ADC_CR2_SWSTART     (1u << 30)
+#define ADC_SQR3_CH1        1u
+
+#define RCC_APB1ENR_TIM3EN  (1u << 1)
+
+#define FIFO_MASK           (ADC_STREAM_FIFO_SIZE - 1u)
+
+/* ------------------------------------------------------------------ */
+/*  State                                                             */
+/* ------------------------------------------------------------------ */
+
+static uint16_t          s_fifo[ADC_STREAM_FIFO_SIZE];
+static volatile uint32_t s_head = 0u;       /* written by ISR */
+static volatile uint32_t s_tail = 0u;       /* written by consumer */
+static volatile uint32_t s_overruns = 0u;
+static uint32_t          s_rate_hz = 0u;
+static bool              s_running = false;
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+bool adc_stream_start(uint32_t rate_hz)
+{
+    if (rate_hz < ADC_STREAM_MIN_HZ || rate_hz > ADC_STREAM_MAX_HZ) return false;
+    if (control_running()) return false;        /* ADC1 is shared */
+
+    adc_stream_stop();
+    analog_init(INTERFACE_ADC_0);
+    trip_reapply();
+
+    s_head     = 0u;
+    s_tail     = 0u;
+    s_overruns = 0u;
+    s_rate_hz  = rate_hz;
+
+    ADC1->SQR3 = ADC_SQR3_CH1;
+    ADC1->CR2 |= ADC_CR2_SWSTART;           /* prime the pipeline */
+
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+    TIM3->CR1  = 0u;
+    TIM3->PSC  = (cycles_core_hz() / 1000000u) - 1u;
+    TIM3->ARR  = (1000000u / rate_hz) - 1u;
+    TIM3->CNT  = 0u;
+    TIM3->EGR  = TIM_EGR_UG;
+    TIM3->SR   = 0u;
+    TIM3->DIER = TIM_DIER_UIE;
+
+    interrupt_Config(IRQ_NO_TIM3, ENABLE);
+    TIM3->CR1  = TIM_CR1_CEN;
+
+    s_running = true;
+    return true;
+}
+
+void adc_stream_stop(void)
+{
+    if (!s_running) return;
+
+    TIM3->CR1  = 0u;
+    TIM3->DIER = 0u;
+    interrupt_Config(IRQ_NO_TIM3, DISABLE);
+    s_running = false;
+}
+
+bool adc_stream_running(void)
+{
+    return s_running;
+}
+
+uint32_t adc_stream_rate(void)
+{
+    return s_rate_hz;
+}
+
+uint32_t adc_stream_pending(void)
+{
+    return s_head - s_tail;
+}
+
+uint32_t adc_stream_read(uint16_t *out, uint32_t max)
+{
+    uint32_t tail  = s_tail;
+    uint32_t avail = s_head - tail;
+    uint32_t n     = (avail < max) ? avail : max;
+
+    for (uint32_t i = 0u; i < n; i++)
+    {
+        out[i] = s_fifo[(tail + i) & FIFO_MASK];
+    }
+    s_tail = tail + n;
+    return n;
+}
+
+uint32_t adc_stream_overruns(void)
+{
+    return s_overruns;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Sample clock                                                      */
+/* ------------------------------------------------------------------ */
+
+void TIM3_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+    uint32_t lat   = irq_timer_latency(TIM3->CNT, TIM3->PSC);
+
+    if (!(TIM3->SR & TIM_SR_UIF))
+    {
+        irq_profile_exit(IRQ_SRC_TIM3, entry, 0u);
+        return;
+    }
+    TIM3->SR = ~TIM_SR_UIF;
+
+    if (ADC1->SR & ADC_SR_EOC)
+    {
+        uint16_t sample = (uint16_t)ADC1->DR;   /* clears EOC */
+        uint32_t head   = s_head;
+
+        if ((head - s_tail) < ADC_STREAM_FIFO_SIZE)
+        {
+            s_fifo[head & FIFO_MASK] = sample;
+            s_head = head + 1u;
+        }
+        else
+        {
+            s_overruns++;
+        }
+    }
+
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+
+    irq_profile_exit(IRQ_SRC_TIM3, entry, lat);
+}
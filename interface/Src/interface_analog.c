@@ -1,5 +1,7 @@
 #include "interface/interface.h"
 #include "interface_defines.h"
+#include "interface_init.h"
+#include "interface_record.h"
 #include "driver_adc.h"
 #include "driver_gpio.h"
 
@@ -27,8 +29,11 @@ static ADC_Config_t s_adc0_cfg = {
     .ADC_DataAlignment = ADC_ALIGN_RIGHT,
 };
 
+/* Once only: a second ADC_Init would drop the analog watchdog bits in CR1 */
 static void adc0_init(void)
 {
+    if (s_adc0_init) return;
+
     GPIO_PinConfig_t pin = {
         .pGPIOx              = GPIOA,
         .GPIO_PinNumber      = GPIO_PIN_NO_1,
@@ -46,7 +51,7 @@ static void adc0_init(void)
 
 static uint16_t adc0_read(void)
 {
-    if (!s_adc0_init) adc0_init();
+    INTERFACE_LAZY_INIT(s_adc0_init, adc0_init);
     uint16_t result = 0u;
     ADC_ReadChannel(ADC1, ADC_CHANNEL_1, &result);
     return result;
@@ -90,7 +95,12 @@ void analog_init(uint8_t channel_id)
 uint16_t analog_read(uint8_t channel_id)
 {
     const adc_instance_t *a = adc_dispatch(channel_id);
-    if (a && a->read) return a->read();
+    if (a && a->read)
+    {
+        uint16_t sample = a->read();
+        record_adc(channel_id, sample);
+        return sample;
+    }
     return 0u;
 }
 
@@ -98,4 +108,13 @@ void analog_deinit(uint8_t channel_id)
 {
     const adc_instance_t *a = adc_dispatch(channel_id);
     if (a && a->deinit) a->deinit();
-}
\ No newline at end of file
+}
+
+#if defined(INTERFACE_PREINIT)
+uint16_t analog_read_fast(uint8_t channel_id)
+{
+    uint16_t sample = s_adc_table[channel_id].read();
+    record_adc(channel_id, sample);
+    return sample;
+}
+#endif
\ No newline at end of file
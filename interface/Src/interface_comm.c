@@ -1,4 +1,5 @@
 #include "interface/interface.h"
+#include "interface_comm.h"
 
 /* ------------------------------------------------------------------ */
 /*  Internal type — private to this file                              */
@@ -8,6 +9,7 @@ typedef struct
 {
     void    (*init)          (void);
     void    (*send)          (uint8_t *buf, uint32_t len);
+    void    (*sendv)         (const comm_iovec_t *iov, uint8_t count);
     uint8_t (*receive)       (uint8_t *buf, uint32_t len);
     uint8_t (*data_available)(void);
     void    (*deinit)        (void);
@@ -19,6 +21,7 @@ typedef struct
 
 extern void    uart2_protocol_init          (void);
 extern void    uart2_protocol_send          (uint8_t *data, uint32_t len);
+extern void    uart2_protocol_sendv         (const comm_iovec_t *iov, uint8_t count);
 extern uint8_t uart2_protocol_receive       (uint8_t *buffer, uint32_t len);
 extern uint8_t uart2_protocol_data_available(void);
 
@@ -26,6 +29,12 @@ extern void    i2c1_protocol_init   (void);
 extern void    i2c1_protocol_send   (uint8_t *data, uint32_t len);
 extern uint8_t i2c1_protocol_receive(uint8_t *buffer, uint32_t len);
 
+extern void    usb_cdc_protocol_init          (void);
+extern void    usb_cdc_protocol_send          (uint8_t *data, uint32_t len);
+extern void    usb_cdc_protocol_sendv         (const comm_iovec_t *iov, uint8_t count);
+extern uint8_t usb_cdc_protocol_receive       (uint8_t *buffer, uint32_t len);
+extern uint8_t usb_cdc_protocol_data_available(void);
+
 /* ------------------------------------------------------------------ */
 /*  Dispatch table                                                     */
 /* ------------------------------------------------------------------ */
@@ -34,6 +43,7 @@ static const comm_instance_t s_comm_table[] = {
     [0] = {
         .init           = uart2_protocol_init,
         .send           = uart2_protocol_send,
+        .sendv          = uart2_protocol_sendv,
         .receive        = uart2_protocol_receive,
         .data_available = uart2_protocol_data_available,
         .deinit         = NULL,
@@ -41,10 +51,19 @@ static const comm_instance_t s_comm_table[] = {
     [1] = {
         .init           = i2c1_protocol_init,
         .send           = i2c1_protocol_send,
+        .sendv          = NULL,
         .receive        = i2c1_protocol_receive,
         .data_available = NULL,
         .deinit         = NULL,
     },
+    [2] = {
+        .init           = usb_cdc_protocol_init,
+        .send           = usb_cdc_protocol_send,
+        .sendv          = usb_cdc_protocol_sendv,
+        .receive        = usb_cdc_protocol_receive,
+        .data_available = usb_cdc_protocol_data_available,
+        .deinit         = NULL,
+    },
 };
 
 #define COMM_COUNT ((uint8_t)(sizeof(s_comm_table) / sizeof(s_comm_table[0])))
@@ -71,6 +90,32 @@ void comm_send(uint8_t comm_id, uint8_t *buf, uint32_t len)
     if (c && c->send) c->send(buf, len);
 }
 
+void comm_sendv(uint8_t comm_id, const comm_iovec_t *iov, uint8_t count)
+{
+    const comm_instance_t *c = comm_dispatch(comm_id);
+    if (c == NULL || iov == NULL || count == 0u) return;
+
+    if (c->sendv)
+    {
+        c->sendv(iov, count);
+    }
+    else if (c->send)
+    {
+        for (uint8_t i = 0u; i < count; i++)
+        {
+            if (iov[i].len == 0u) continue;
+            c->send((uint8_t *)iov[i].base, iov[i].len);
+        }
+    }
+}
+
+void comm_send_owned(uint8_t comm_id, void *block, uint32_t len, comm_release_t release)
+{
+    const comm_instance_t *c = comm_dispatch(comm_id);
+    if (c && c->send && block) c->send((uint8_t *)block, len);
+    if (release && block) release(block);
+}
+
 uint8_t comm_receive(uint8_t comm_id, uint8_t *buf, uint32_t len)
 {
     const comm_instance_t *c = comm_dispatch(comm_id);
@@ -0,0 +1,195 @@
+#include "interface_control.h"
+#include "interface/interface.h"
+#include "interface_defines.h"
+#include "interface_cycles.h"
+#include "interface_irq.h"
+#include "interface_adc_stream.h"
+#include "interface_trip.h"
+#include "driver_adc.h"
+#include "driver_timer.h"
+#include "driver_interrupt.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/*  Registers                                                         */
+/* ------------------------------------------------------------------ */
+
+#define TIM_CR1_CEN         (1u << 0)
+#define TIM_DIER_UIE        (1u << 0)
+#define TIM_SR_UIF          (1u << 0)
+#define TIM_EGR_UG          (1u << 0)
+
+#define ADC_SR_EOC          (1u << 1)
+#define ADC_CR2_SWSTART     (1u << 30)
+#define ADC_SQR3_CH1        1u
+#define ADC_SMPR2_CH1_POS   3u
+#define ADC_SMPR2_CH1_MASK  (7u << ADC_SMPR2_CH1_POS)
+#define ADC_SMP_56CYC       3u          /* ~8.5 us conversion at 8 MHz ADCCLK */
+
+#define RCC_APB1ENR_TIM4EN  (1u << 2)
+
+#define CONTROL_PWM_TIM     TIM2        /* PWM0 — PA5, TIM2 CH1 */
+
+/* ------------------------------------------------------------------ */
+/*  State                                                             */
+/* ------------------------------------------------------------------ */
+
+static pid_q16_t         s_pid;
+static volatile int32_t  s_setpoint = 0;
+static uint32_t          s_rate_hz = 0u;
+static bool              s_running = false;
+
+static control_stats_t   s_stats;
+static uint32_t          s_last_entry = 0u;
+static uint32_t          s_saved_smpr2 = 0u;
+static uint32_t          s_saved_ccr1 = 0u;
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+bool control_start(uint32_t rate_hz, const pid_q16_t *gains, int32_t setpoint)
+{
+    if (gains == NULL) return false;
+    if (rate_hz < CONTROL_MIN_HZ || rate_hz > CONTROL_MAX_HZ) return false;
+    if (adc_stream_running()) return false;     /* ADC1 is shared */
+    if (trip_latched()) return false;           /* output held off until trip_rearm() */
+
+    control_stop();
+
+    analog_init(INTERFACE_ADC_0);
+    PWM_init(INTERFACE_PWM_0);
+    trip_reapply();
+
+    int32_t pwm_max = (int32_t)CONTROL_PWM_TIM->ARR + 1;
+    s_saved_ccr1    = CONTROL_PWM_TIM->CCR1;    /* open-loop duty, back on stop */
+
+    s_pid = *gains;
+    if (s_pid.out_min < 0)       s_pid.out_min = 0;
+    if (s_pid.out_max > pwm_max) s_pid.out_max = pwm_max;
+    if (s_pid.out_max <= s_pid.out_min) s_pid.out_max = pwm_max;
+    pid_q16_reset(&s_pid, (int32_t)analog_read(INTERFACE_ADC_0));
+
+    s_setpoint = setpoint;
+    s_rate_hz  = rate_hz;
+    control_stats_reset();
+
+    /* ADC0's 480-cycle sample time cannot keep up with 20 kHz */
+    s_saved_smpr2 = ADC1->SMPR2;
+    ADC1->SMPR2   = (s_saved_smpr2 & ~ADC_SMPR2_CH1_MASK) | (ADC_SMP_56CYC << ADC_SMPR2_CH1_POS);
+    ADC1->SQR3    = ADC_SQR3_CH1;
+    ADC1->CR2    |= ADC_CR2_SWSTART;
+
+    RCC->APB1ENR |= RCC_APB1ENR_TIM4EN;
+    TIM4->CR1  = 0u;
+    TIM4->PSC  = (cycles_core_hz() / 1000000u) - 1u;
+    TIM4->ARR  = (1000000u / rate_hz) - 1u;
+    TIM4->CNT  = 0u;
+    TIM4->EGR  = TIM_EGR_UG;
+    TIM4->SR   = 0u;
+    TIM4->DIER = TIM_DIER_UIE;
+
+    s_running = true;
+    interrupt_Config(IRQ_NO_TIM4, ENABLE);
+    TIM4->CR1  = TIM_CR1_CEN;
+    return true;
+}
+
+void control_stop(void)
+{
+    if (!s_running) return;
+
+    TIM4->CR1  = 0u;
+    TIM4->DIER = 0u;
+    interrupt_Config(IRQ_NO_TIM4, DISABLE);
+    ADC1->SMPR2 = s_saved_smpr2;
+    CONTROL_PWM_TIM->CCR1 = s_saved_ccr1;
+    s_running = false;
+}
+
+bool control_running(void)
+{
+    return s_running;
+}
+
+uint32_t control_rate(void)
+{
+    return s_rate_hz;
+}
+
+void control_set_setpoint(int32_t setpoint)
+{
+    s_setpoint = setpoint;
+}
+
+int32_t control_setpoint(void)
+{
+    return s_setpoint;
+}
+
+void control_stats(control_stats_t *out)
+{
+    if (out == NULL) return;
+    uint32_t primask = irq_save();
+    *out = s_stats;
+    irq_restore(primask);
+}
+
+void control_stats_reset(void)
+{
+    uint32_t primask = irq_save();
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_stats.period_min_cyc = 0xFFFFFFFFu;
+    s_last_entry = 0u;
+    irq_restore(primask);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Loop ISR                                                          */
+/* ------------------------------------------------------------------ */
+
+void TIM4_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+    uint32_t lat   = irq_timer_latency(TIM4->CNT, TIM4->PSC);
+
+    if (!(TIM4->SR & TIM_SR_UIF))
+    {
+        irq_profile_exit(IRQ_SRC_TIM4, entry, 0u);
+        return;
+    }
+    TIM4->SR = ~TIM_SR_UIF;
+
+    if (s_last_entry != 0u)
+    {
+        uint32_t period = entry - s_last_entry;
+        if (period < s_stats.period_min_cyc) s_stats.period_min_cyc = period;
+        if (period > s_stats.period_max_cyc) s_stats.period_max_cyc = period;
+    }
+    s_last_entry = entry;
+
+    if (ADC1->SR & ADC_SR_EOC)
+    {
+        int32_t meas = (int32_t)(ADC1->DR & 0x0FFFu);
+        int32_t out  = pid_q16_update(&s_pid, s_setpoint, meas);
+
+        CONTROL_PWM_TIM->CCR1 = (uint32_t)out;
+
+        s_stats.last_meas = meas;
+        s_stats.last_out  = out;
+    }
+    else
+    {
+        s_stats.missed++;
+    }
+
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+
+    uint32_t exec = cycles_now() - entry;
+    s_stats.exec_last_cyc = exec;
+    if (exec > s_stats.exec_worst_cyc) s_stats.exec_worst_cyc = exec;
+    s_stats.runs++;
+
+    irq_profile_exit(IRQ_SRC_TIM4, entry, lat);
+}
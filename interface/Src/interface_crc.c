@@ -0,0 +1,183 @@
+#include "interface_crc.h"
+#include "interface_init.h"
+#include "interface_defines.h"
+#include "interface_cycles.h"
+
+/* ------------------------------------------------------------------ */
+/*  Registers                                                         */
+/* ------------------------------------------------------------------ */
+
+typedef struct
+{
+    volatile uint32_t DR;
+    volatile uint32_t IDR;
+    volatile uint32_t CR;
+} crc_regs_t;
+
+typedef struct
+{
+    volatile uint32_t CR;
+    volatile uint32_t NDTR;
+    volatile uint32_t PAR;
+    volatile uint32_t M0AR;
+    volatile uint32_t M1AR;
+    volatile uint32_t FCR;
+} dma_stream_regs_t;
+
+typedef struct
+{
+    volatile uint32_t LISR;
+    volatile uint32_t HISR;
+    volatile uint32_t LIFCR;
+    volatile uint32_t HIFCR;
+    dma_stream_regs_t S[8];
+} dma_regs_t;
+
+#define CRC_REGS                ((crc_regs_t *)0x40023000UL)
+#define DMA2_REGS               ((dma_regs_t *)0x40026400UL)
+
+#define RCC_AHB1ENR_CRCEN       (1u << 12)
+#define RCC_AHB1ENR_DMA2EN      (1u << 22)
+#define CRC_CR_RESET            (1u << 0)
+
+/* Only DMA2 can do memory-to-memory; stream 0 is otherwise unused here */
+#define CRC_DMA_STREAM          (&DMA2_REGS->S[0])
+#define DMA_S0_TCIF             (1u << 5)
+#define DMA_S0_TEIF             (1u << 3)
+#define DMA_S0_ALL_FLAGS        0x3Du
+
+#define DMA_SxCR_EN             (1u << 0)
+#define DMA_SxCR_DIR_M2M        (2u << 6)
+#define DMA_SxCR_PINC           (1u << 9)
+#define DMA_SxCR_PSIZE_32       (2u << 11)
+#define DMA_SxCR_MSIZE_32       (2u << 13)
+#define DMA_SxFCR_DMDIS         (1u << 2)   /* M2M needs the FIFO */
+#define DMA_SxFCR_FTH_FULL      (3u << 0)
+#define DMA_NDTR_MAX            0xFFFFu
+
+/* Poll budget: M2M into DR takes a few AHB cycles a word; far above that means a stuck stream */
+#define CRC_DMA_CYC_PER_WORD    16u
+#define CRC_DMA_CYC_SLACK       1024u
+
+static uint8_t s_crc_is_init = 0u;
+
+/*
+ * The F4 unit has no writable initial value, only a reset to 0xFFFFFFFF.
+ * One word steers it to any state: the 32-step register update is a
+ * bijection, so running it backwards from the wanted value gives the word
+ * to feed after reset.
+ */
+static uint32_t crc_unshift(uint32_t x)
+{
+    for (uint8_t i = 0u; i < 32u; i++)
+    {
+        x = (x & 1u) ? (((x ^ CRC32_POLY) >> 1) | 0x80000000u) : (x >> 1);
+    }
+    return x;
+}
+
+static void crc_hw_resume(uint32_t crc)
+{
+    if (CRC_REGS->DR == crc) return;     /* unit already holds this context */
+
+    CRC_REGS->CR = CRC_CR_RESET;
+    if (crc != CRC32_INIT)
+    {
+        CRC_REGS->DR = crc_unshift(crc) ^ CRC32_INIT;
+    }
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+void crc_init(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_CRCEN | RCC_AHB1ENR_DMA2EN;
+    CRC_REGS->CR  = CRC_CR_RESET;
+    s_crc_is_init = 1u;
+}
+
+uint32_t crc32_words_hw(uint32_t crc, const uint32_t *words, size_t count)
+{
+    INTERFACE_LAZY_INIT(s_crc_is_init, crc_init);
+    crc_hw_resume(crc);
+
+    while (count >= 4u)
+    {
+        CRC_REGS->DR = words[0];
+        CRC_REGS->DR = words[1];
+        CRC_REGS->DR = words[2];
+        CRC_REGS->DR = words[3];
+        words += 4;
+        count -= 4u;
+    }
+    while (count--)
+    {
+        CRC_REGS->DR = *words++;
+    }
+    return CRC_REGS->DR;
+}
+
+uint32_t crc32_words_dma(uint32_t crc, const uint32_t *words, size_t count)
+{
+    INTERFACE_LAZY_INIT(s_crc_is_init, crc_init);
+
+    const uint32_t *start = words;
+    size_t          total = count;
+    dma_stream_regs_t *s  = CRC_DMA_STREAM;
+
+    crc_hw_resume(crc);
+
+    while (count != 0u)
+    {
+        uint32_t chunk = (count > DMA_NDTR_MAX) ? DMA_NDTR_MAX : (uint32_t)count;
+
+        s->CR = 0u;
+        uint32_t t0 = cycles_now();
+        while (s->CR & DMA_SxCR_EN)
+        {
+            if (cycles_now() - t0 > CRC_DMA_CYC_SLACK) return crc32_words_hw(crc, start, total);
+        }
+        DMA2_REGS->LIFCR = DMA_S0_ALL_FLAGS;
+
+        /* M2M: the "peripheral" port is the source, memory port the sink */
+        s->PAR  = (uint32_t)(uintptr_t)words;
+        s->M0AR = (uint32_t)(uintptr_t)&CRC_REGS->DR;
+        s->NDTR = chunk;
+        s->FCR  = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH_FULL;
+        s->CR   = DMA_SxCR_DIR_M2M | DMA_SxCR_PINC |
+                  DMA_SxCR_PSIZE_32 | DMA_SxCR_MSIZE_32 | DMA_SxCR_EN;
+
+        uint32_t isr;
+        uint32_t budget = chunk * CRC_DMA_CYC_PER_WORD + CRC_DMA_CYC_SLACK;
+        t0 = cycles_now();
+        do
+        {
+            isr = DMA2_REGS->LISR;
+            if (cycles_now() - t0 > budget)
+            {
+                s->CR = 0u;
+                isr   = DMA_S0_TEIF;    /* treat a stuck transfer like a bus error */
+                break;
+            }
+        } while (!(isr & (DMA_S0_TCIF | DMA_S0_TEIF)));
+        DMA2_REGS->LIFCR = DMA_S0_ALL_FLAGS;
+
+        if (isr & DMA_S0_TEIF)
+        {
+            /* unit state is unknown after a bus error — redo the block on the CPU */
+            return crc32_words_hw(crc, start, total);
+        }
+
+        words += chunk;
+        count -= chunk;
+    }
+    return CRC_REGS->DR;
+}
+
+uint32_t crc32_words(uint32_t crc, const uint32_t *words, size_t count)
+{
+    if (count >= CRC_DMA_MIN_WORDS) return crc32_words_dma(crc, words, count);
+    return crc32_words_hw(crc, words, count);
+}
@@ -0,0 +1,43 @@
+#include "interface_cycles.h"
+
+/* ------------------------------------------------------------------ */
+/*  Cortex-M4 debug registers                                         */
+/* ------------------------------------------------------------------ */
+
+#define DEMCR_REG       (*(volatile uint32_t *)0xE000EDFCUL)
+#define DWT_CTRL_REG    (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_LAR_REG     (*(volatile uint32_t *)0xE0001FB0UL)
+
+#define DEMCR_TRCENA        (1UL << 24)
+#define DWT_CTRL_CYCCNTENA  (1UL << 0)
+#define DWT_LAR_UNLOCK      0xC5ACCE55UL
+
+static uint32_t s_core_hz = CYCLES_DEFAULT_CORE_HZ;
+
+void cycles_init(uint32_t core_hz)
+{
+    if (core_hz != 0u) s_core_hz = core_hz;
+
+    DEMCR_REG   |= DEMCR_TRCENA;
+    DWT_LAR_REG  = DWT_LAR_UNLOCK;
+    if (!(DWT_CTRL_REG & DWT_CTRL_CYCCNTENA))
+    {
+        DWT_CYCCNT_REG = 0u;
+        DWT_CTRL_REG  |= DWT_CTRL_CYCCNTENA;
+    }
+}
+
+uint32_t cycles_core_hz(void)
+{
+    return s_core_hz;
+}
+
+uint32_t cycles_to_us(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000ULL) / s_core_hz);
+}
+
+uint32_t cycles_to_ns(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 1000000000ULL) / s_core_hz);
+}
@@ -0,0 +1,308 @@
+#include "interface_dim.h"
+#include "interface/interface.h"
+#include "interface_io_hw.h"
+#include "interface_cycles.h"
+#include "interface_irq.h"
+#include "driver_timer.h"
+#include "driver_interrupt.h"
+
+/* ------------------------------------------------------------------ */
+/*  Registers                                                         */
+/* ------------------------------------------------------------------ */
+
+#define TIM_CR1_CEN         (1u << 0)
+#define TIM_CR1_ARPE        (1u << 7)
+#define TIM_DIER_UIE        (1u << 0)
+#define TIM_SR_UIF          (1u << 0)
+#define TIM_EGR_UG          (1u << 0)
+
+#define RCC_APB2ENR_TIM10EN (1u << 17)
+
+#define DIM_TIM             TIM10
+#define DIM_TICK_HZ         1000000u
+#define DIM_FRAME_UNITS     ((1u << DIM_BITS) - 1u)
+
+/* ------------------------------------------------------------------ */
+/*  Gamma 2.2, 8-bit in / 8-bit out                                   */
+/* ------------------------------------------------------------------ */
+
+static const uint8_t s_gamma[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+/* ------------------------------------------------------------------ */
+/*  State                                                             */
+/* ------------------------------------------------------------------ */
+
+typedef struct
+{
+    bool     used;
+    bool     inverted;
+    bool     gamma;
+    uint8_t  pin_id;
+    uint8_t  pin;
+    uint8_t  port;          /* index into s_ports[] */
+    uint8_t  level;
+} dim_led_t;
+
+static dim_led_t          s_leds[DIM_MAX_LEDS];
+static GPIO_RegDef_t     *s_ports[DIM_MAX_PORTS];
+static volatile uint8_t   s_port_count = 0u;
+
+/* [buffer][port][plane] BSRR words, double-buffered */
+static uint32_t           s_planes[2][DIM_MAX_PORTS][DIM_BITS];
+static volatile uint8_t   s_front = 0u;
+static volatile bool      s_swap_pending = false;
+static volatile uint8_t   s_next_plane = 0u;
+
+static uint32_t           s_unit_ticks = 1u;
+static uint32_t           s_frame_hz = 0u;
+static bool               s_running = false;
+
+static volatile uint32_t  s_isr_count = 0u;
+static volatile uint32_t  s_isr_cycles = 0u;    /* sum, for the average */
+static volatile uint32_t  s_isr_worst = 0u;
+
+static dim_led_t *find_led(uint8_t pin_id)
+{
+    for (uint8_t i = 0u; i < DIM_MAX_LEDS; i++)
+    {
+        if (s_leds[i].used && s_leds[i].pin_id == pin_id) return &s_leds[i];
+    }
+    return NULL;
+}
+
+static int8_t port_index(GPIO_RegDef_t *port)
+{
+    for (uint8_t i = 0u; i < s_port_count; i++)
+    {
+        if (s_ports[i] == port) return (int8_t)i;
+    }
+    if (s_port_count >= DIM_MAX_PORTS) return -1;
+    s_ports[s_port_count] = port;
+    return (int8_t)s_port_count++;
+}
+
+/* Fill the back buffer, then let the ISR swap at the next frame start */
+static void rebuild(void)
+{
+    s_swap_pending = false;
+    uint8_t back = s_front ^ 1u;
+
+    for (uint8_t p = 0u; p < DIM_MAX_PORTS; p++)
+    {
+        for (uint8_t k = 0u; k < DIM_BITS; k++) s_planes[back][p][k] = 0u;
+    }
+
+    for (uint8_t i = 0u; i < DIM_MAX_LEDS; i++)
+    {
+        const dim_led_t *led = &s_leds[i];
+        if (!led->used) continue;
+
+        uint8_t  level = led->gamma ? s_gamma[led->level] : led->level;
+        uint32_t on    = 1UL << (led->pin + (led->inverted ? 16u : 0u));
+        uint32_t off   = 1UL << (led->pin + (led->inverted ? 0u : 16u));
+
+        for (uint8_t k = 0u; k < DIM_BITS; k++)
+        {
+            s_planes[back][led->port][k] |= (level & (1u << k)) ? on : off;
+        }
+    }
+
+    if (s_running) s_swap_pending = true;
+    else           s_front = back;
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+bool dim_attach(uint8_t pin_id, bool inverted)
+{
+    GPIO_RegDef_t *port;
+    uint8_t        pin;
+
+    if (!IO_get_hw(pin_id, &port, &pin)) return false;
+    if (IO_init(pin_id) != IO_OK) return false;
+
+    dim_led_t *led = find_led(pin_id);
+    for (uint8_t i = 0u; led == NULL && i < DIM_MAX_LEDS; i++)
+    {
+        if (!s_leds[i].used) led = &s_leds[i];
+    }
+    if (led == NULL) return false;
+
+    int8_t idx = port_index(port);
+    if (idx < 0) return false;
+
+    led->used     = true;
+    led->inverted = inverted;
+    led->gamma    = true;
+    led->pin_id   = pin_id;
+    led->pin      = pin;
+    led->port     = (uint8_t)idx;
+    led->level    = 0u;
+    rebuild();
+    return true;
+}
+
+void dim_detach(uint8_t pin_id)
+{
+    dim_led_t *led = find_led(pin_id);
+    if (led == NULL) return;
+    led->used = false;
+    rebuild();
+}
+
+bool dim_owns(uint8_t pin_id)
+{
+    return find_led(pin_id) != NULL;
+}
+
+void dim_set(uint8_t pin_id, uint8_t level)
+{
+    dim_led_t *led = find_led(pin_id);
+    if (led == NULL) return;
+    led->level = level;
+    rebuild();
+}
+
+void dim_set_gamma(uint8_t pin_id, bool enable)
+{
+    dim_led_t *led = find_led(pin_id);
+    if (led == NULL) return;
+    led->gamma = enable;
+    rebuild();
+}
+
+bool dim_start(uint32_t frame_hz)
+{
+    if (frame_hz == 0u) return false;
+
+    s_unit_ticks = DIM_TICK_HZ / (frame_hz * DIM_FRAME_UNITS);
+    if (s_unit_ticks == 0u) return false;
+
+    dim_stop();
+    s_frame_hz   = frame_hz;
+    s_isr_count  = 0u;
+    s_isr_cycles = 0u;
+    s_isr_worst  = 0u;
+
+    /* plane 0 goes out now, the ISR continues from plane 1 */
+    for (uint8_t p = 0u; p < s_port_count; p++)
+    {
+        s_ports[p]->BSRR = s_planes[s_front][p][0];
+    }
+    s_next_plane = 1u;
+
+    RCC->APB2ENR |= RCC_APB2ENR_TIM10EN;
+    DIM_TIM->CR1  = TIM_CR1_ARPE;
+    DIM_TIM->PSC  = (cycles_core_hz() / DIM_TICK_HZ) - 1u;
+    DIM_TIM->ARR  = s_unit_ticks - 1u;
+    DIM_TIM->CNT  = 0u;
+    DIM_TIM->EGR  = TIM_EGR_UG;
+    DIM_TIM->ARR  = (s_unit_ticks << 1) - 1u;      /* preload plane 1 */
+    DIM_TIM->SR   = 0u;
+    DIM_TIM->DIER = TIM_DIER_UIE;
+
+    s_running = true;
+    interrupt_Config(IRQ_NO_TIM1_UP_TIM10, ENABLE);
+    DIM_TIM->CR1 |= TIM_CR1_CEN;
+    return true;
+}
+
+void dim_stop(void)
+{
+    if (!s_running) return;
+
+    DIM_TIM->CR1  = 0u;
+    DIM_TIM->DIER = 0u;
+    interrupt_Config(IRQ_NO_TIM1_UP_TIM10, DISABLE);
+    s_running = false;
+
+    if (s_swap_pending)
+    {
+        s_front ^= 1u;
+        s_swap_pending = false;
+    }
+}
+
+bool dim_running(void)
+{
+    return s_running;
+}
+
+void dim_stats(dim_stats_t *out)
+{
+    if (out == NULL) return;
+
+    uint32_t count = s_isr_count;
+    out->frame_hz      = s_frame_hz;
+    out->isr_count     = count;
+    out->isr_worst_cyc = s_isr_worst;
+    out->isr_avg_cyc   = count ? (s_isr_cycles / count) : 0u;
+    out->load_ppm      = (uint32_t)(((uint64_t)out->isr_avg_cyc * s_frame_hz * DIM_BITS * 1000000ULL)
+                                    / cycles_core_hz());
+}
+
+/* ------------------------------------------------------------------ */
+/*  Plane ISR                                                         */
+/* ------------------------------------------------------------------ */
+
+void TIM1_UP_TIM10_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+    uint32_t lat   = irq_timer_latency(DIM_TIM->CNT, DIM_TIM->PSC);
+
+    if (!(DIM_TIM->SR & TIM_SR_UIF))
+    {
+        irq_profile_exit(IRQ_SRC_TIM10, entry, 0u);
+        return;
+    }
+    DIM_TIM->SR = ~TIM_SR_UIF;
+
+    uint8_t plane = s_next_plane;
+    if (plane == 0u && s_swap_pending)
+    {
+        s_front ^= 1u;
+        s_swap_pending = false;
+    }
+
+    const uint32_t (*words)[DIM_BITS] = s_planes[s_front];
+    for (uint8_t p = 0u; p < s_port_count; p++)
+    {
+        s_ports[p]->BSRR = words[p][plane];
+    }
+
+    /* the ARR written now is the length of the next plane */
+    uint8_t next = (uint8_t)((plane + 1u) & (DIM_BITS - 1u));
+    DIM_TIM->ARR = (s_unit_ticks << next) - 1u;
+    s_next_plane = next;
+
+    uint32_t cyc = cycles_now() - entry;
+    if (s_isr_cycles + cyc < s_isr_cycles)
+    {
+        s_isr_cycles = 0u;          /* restart the average on overflow */
+        s_isr_count  = 0u;
+    }
+    s_isr_cycles += cyc;
+    s_isr_count++;
+    if (cyc > s_isr_worst) s_isr_worst = cyc;
+
+    irq_profile_exit(IRQ_SRC_TIM10, entry, lat);
+}
@@ -0,0 +1,27 @@
+#include "interface_fast.h"
+
+/* From app/fast_ram.ld */
+extern uint32_t       _sfast;
+extern uint32_t       _efast;
+extern const uint32_t _sifast;
+
+void fast_copy_init(void)
+{
+    const uint32_t *src = &_sifast;
+    uint32_t       *dst = &_sfast;
+
+    while (dst < &_efast)
+    {
+        *dst++ = *src++;
+    }
+}
+
+uint32_t fast_size(void)
+{
+    return (uint32_t)((uintptr_t)&_efast - (uintptr_t)&_sfast);
+}
+
+uint32_t fast_load_end(void)
+{
+    return (uint32_t)(uintptr_t)&_sifast + fast_size();
+}
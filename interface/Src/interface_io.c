@@ -6,11 +6,16 @@
  * Generic functions operate on the config — no per-pin code generation.
  *
  * To add a new pin:
- * 1. Add an entry to s_pin_configs[]
- * No public header changes needed.
+ * 1. Add a line to INTERFACE_IO_PINS in interface_io_pins.h
+ * The table below and board::Io in interface_hal.hpp both expand it.
  */
 
 #include "interface/interface.h"
+#include "interface_init.h"
+#include "interface_record.h"
+#include "interface_io_hw.h"
+#include "interface_io_pins.h"
+#include "interface_fast.h"
 #include "driver_gpio.h"
 
 /* ------------------------------------------------------------------ */
@@ -27,16 +32,20 @@ typedef struct
     uint8_t         default_pupd;
 } io_pin_config_t;
 
-static const io_pin_config_t s_pin_configs[] = {
-/* [pin_id] = { port,  pin,             mode,           speed,          otype,        pupd           } */
-    [0] = { GPIOC, GPIO_PIN_NO_13, GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD },  /* PC13 */
-    [1] = { GPIOA, GPIO_PIN_NO_5,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD },  /* PA5  */
-    [2] = { GPIOB, GPIO_PIN_NO_3,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD },  /* PB3  */
-    [3] = { GPIOB, GPIO_PIN_NO_4,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD },  /* PB4  */
-    [4] = { GPIOB, GPIO_PIN_NO_5,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD },  /* PB5  */
-    [5] = { GPIOA, GPIO_PIN_NO_0,  GPIO_MODE_OUT, GPIO_SPEED_LOW, GPIO_OP_TYPE_PP, GPIO_NO_PUPD },  /* PA0  */
+/*
+ * Read on every IO_* call. FAST_DATA copies it to SRAM with the IO_*_fast
+ * paths below, so despite the const it sits in writable memory: a stray
+ * write can corrupt it, and flash no longer protects it.
+ */
+#define IO_PIN_CONFIG(id, port, pin, mode, speed, otype, pupd) \
+    [id] = { GPIO##port, GPIO_PIN_NO_##pin, mode, speed, otype, pupd },
+
+FAST_DATA static const io_pin_config_t s_pin_configs[] = {
+    INTERFACE_IO_PINS(IO_PIN_CONFIG)
 };
 
+#undef IO_PIN_CONFIG
+
 #define IO_PIN_COUNT  ((uint8_t)(sizeof(s_pin_configs) / sizeof(s_pin_configs[0])))
 
 /* ------------------------------------------------------------------ */
@@ -71,13 +80,11 @@ static const io_pin_config_t *io_get_config(uint8_t pin_id)
 }
 
 /* ------------------------------------------------------------------ */
-/* Internal: lazy-init helper                                         */
+/* Internal: init helpers                                             */
 /* ------------------------------------------------------------------ */
 
-static io_status_t io_ensure_init(uint8_t pin_id, const io_pin_config_t *cfg)
+static io_status_t io_do_init(uint8_t pin_id, const io_pin_config_t *cfg)
 {
-    if (pin_is_init(pin_id)) return IO_OK;
-
     GPIO_PinConfig_t gpio_cfg;
     gpio_cfg.pGPIOx              = cfg->port;
     gpio_cfg.GPIO_PinNumber      = cfg->pin;
@@ -93,6 +100,18 @@ static io_status_t io_ensure_init(uint8_t pin_id, const io_pin_config_t *cfg)
     return IO_OK;
 }
 
+static io_status_t io_ensure_init(uint8_t pin_id, const io_pin_config_t *cfg)
+{
+#if defined(INTERFACE_PREINIT)
+    (void)pin_id;
+    (void)cfg;
+    return IO_OK;
+#else
+    if (pin_is_init(pin_id)) return IO_OK;
+    return io_do_init(pin_id, cfg);
+#endif
+}
+
 /* ================================================================== */
 /* Public functions declared in interface.h                           */
 /* ================================================================== */
@@ -101,7 +120,8 @@ io_status_t IO_init(uint8_t pin_id)
 {
     const io_pin_config_t *cfg = io_get_config(pin_id);
     if (cfg == NULL) return IO_ERR_INVALID_PIN;
-    return io_ensure_init(pin_id, cfg);
+    if (pin_is_init(pin_id)) return IO_OK;
+    return io_do_init(pin_id, cfg);
 }
 
 io_status_t IO_write(uint8_t pin_id, uint8_t value)
@@ -127,6 +147,7 @@ io_status_t IO_read(uint8_t pin_id, uint8_t *out_value)
     if (s != IO_OK) return s;
 
     *out_value = GPIO_ReadFromInputPin(cfg->port, cfg->pin);
+    record_gpio(pin_id, *out_value);
     return IO_OK;
 }
 
@@ -166,4 +187,45 @@ io_status_t IO_deinit(uint8_t pin_id)
     if (pin_id >= IO_PIN_COUNT) return IO_ERR_INVALID_PIN;
     pin_clear_init(pin_id);
     return IO_OK;
-}
\ No newline at end of file
+}
+
+bool IO_get_hw(uint8_t pin_id, GPIO_RegDef_t **port, uint8_t *pin)
+{
+    const io_pin_config_t *cfg = io_get_config(pin_id);
+    if (cfg == NULL || port == NULL || pin == NULL) return false;
+    *port = cfg->port;
+    *pin  = cfg->pin;
+    return true;
+}
+
+#if defined(INTERFACE_PREINIT)
+
+/* ------------------------------------------------------------------ */
+/* Fast paths — no bounds or init checks (see interface_init.h)       */
+/*                                                                    */
+/* They run from SRAM, so they touch the GPIO registers directly: a   */
+/* call into the GPIO driver would go back out to flash.              */
+/* ------------------------------------------------------------------ */
+
+FAST_CODE void IO_write_fast(uint8_t pin_id, uint8_t value)
+{
+    const io_pin_config_t *cfg = &s_pin_configs[pin_id];
+    cfg->port->BSRR = value ? (1UL << cfg->pin) : (1UL << (cfg->pin + 16u));
+}
+
+FAST_CODE void IO_toggle_fast(uint8_t pin_id)
+{
+    const io_pin_config_t *cfg = &s_pin_configs[pin_id];
+    uint32_t bit = 1UL << cfg->pin;
+    cfg->port->BSRR = (cfg->port->ODR & bit) ? (bit << 16) : bit;
+}
+
+FAST_CODE uint8_t IO_read_fast(uint8_t pin_id)
+{
+    const io_pin_config_t *cfg = &s_pin_configs[pin_id];
+    uint8_t value = (uint8_t)((cfg->port->IDR >> cfg->pin) & 1u);
+    record_gpio(pin_id, value);
+    return value;
+}
+
+#endif /* INTERFACE_PREINIT */
\ No newline at end of file
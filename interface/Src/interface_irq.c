@@ -0,0 +1,146 @@
+#include "interface_irq.h"
+#include "interface_defines.h"
+#include "interface_fast.h"
+#include "driver_gpio.h"
+#include "driver_interrupt.h"
+
+/* ------------------------------------------------------------------ */
+/*  Cortex-M4 system control registers                                */
+/* ------------------------------------------------------------------ */
+
+#define SCB_AIRCR_REG       (*(volatile uint32_t *)0xE000ED0CUL)
+#define SCB_SHPR_BASE       ((volatile uint8_t *)0xE000ED18UL)
+#define NVIC_IPR_BASE       ((volatile uint8_t *)0xE000E400UL)
+
+#define AIRCR_VECTKEY       (0x05FAUL << 16)
+#define AIRCR_PRIGROUP_POS  8u
+#define AIRCR_PRIGROUP_MASK (7UL << AIRCR_PRIGROUP_POS)
+
+/*
+ * STM32F4 implements the top 4 priority bits. PRIGROUP 5 splits them
+ * as [7:6] preempt and [5:4] sub-priority.
+ */
+#define IRQ_PRIGROUP        5u
+#define IRQ_PRIO_BYTE(pre, sub)  (uint8_t)((((pre) & 3u) << 6) | (((sub) & 3u) << 4))
+
+#define SYSTICK_EXC_NUM     15      /* SHPR index = exception number - 4 */
+
+/* ------------------------------------------------------------------ */
+/*  Plan                                                              */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Level 0 — the trip paths. Both only force PWM off and latch, a few
+ *           hundred cycles. They preempt every other handler and run
+ *           through irq_save() sections; only the short irq_save_all()
+ *           sections on trip and profile state hold them off.
+ * Level 1 — the control loop, then console RX. The PID step is far
+ *           shorter than one UART byte time (87 us at 115200), so RX
+ *           waiting behind it can never overrun.
+ * Level 2 — soft real-time pacing: ADC stream and BAM dimmer, then USB.
+ *           The OTG core NAKs the host while an event waits, so USB
+ *           only loses bandwidth, never data.
+ * Level 3 — bookkeeping: timebase overflow and SysTick. TIM5 wraps every
+ *           71 minutes and timebase_us_get() corrects for one pending
+ *           wrap. A SysTick held off past the next tick loses a 1 ms
+ *           tick, so everything above must stay well under 1 ms.
+ */
+static const irq_plan_entry_t s_irq_plan[IRQ_SRC_COUNT] = {
+    [IRQ_SRC_EXTI0]   = { "exti0",   IRQ_NO_EXTI0,          0u, 0u },
+    [IRQ_SRC_ADC]     = { "adc",     IRQ_NO_ADC,            0u, 1u },
+    [IRQ_SRC_TIM4]    = { "tim4",    IRQ_NO_TIM4,           1u, 0u },
+    [IRQ_SRC_USART2]  = { "usart2",  IRQ_NO_UART2,          1u, 1u },
+    [IRQ_SRC_TIM3]    = { "tim3",    IRQ_NO_TIM3,           2u, 0u },
+    [IRQ_SRC_TIM10]   = { "tim10",   IRQ_NO_TIM1_UP_TIM10,  2u, 1u },
+    [IRQ_SRC_OTG_FS]  = { "otg_fs",  IRQ_NO_OTG_FS,         2u, 2u },
+    [IRQ_SRC_TIM5]    = { "tim5",    IRQ_NO_TIM5,           3u, 0u },
+    [IRQ_SRC_SYSTICK] = { "systick", -1,                    3u, 1u },
+};
+
+#if IRQ_BASEPRI_MASK != (1u << 6)
+#error "IRQ_BASEPRI_MASK must be the priority byte of preempt level 1"
+#endif
+
+static irq_profile_t s_profile[IRQ_SRC_COUNT];
+
+#ifdef IRQ_PROFILE_MARKER
+#define IRQ_MARKER_PORT     GPIOA
+
+uint8_t irq_marker_depth = 0u;
+
+static void irq_marker_init(void)
+{
+    GPIO_PinConfig_t pin = {
+        .pGPIOx              = IRQ_MARKER_PORT,
+        .GPIO_PinNumber      = IRQ_MARKER_PIN,
+        .GPIO_PinMode        = GPIO_MODE_OUT,
+        .GPIO_PinSpeed       = GPIO_SPEED_HIGH,
+        .GPIO_PinOPType      = GPIO_OP_TYPE_PP,
+        .GPIO_PinPuPdControl = GPIO_NO_PUPD,
+        .GPIO_PinAltFunMode  = GPIO_PIN_NO_ALTFN,
+    };
+    GPIO_Init(&pin);
+    IRQ_MARKER_BSRR = (1u << (IRQ_MARKER_PIN + 16u));
+}
+#endif
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+void irq_plan_apply(void)
+{
+    uint32_t aircr = SCB_AIRCR_REG & ~(AIRCR_PRIGROUP_MASK | 0xFFFF0000UL);
+    SCB_AIRCR_REG  = aircr | AIRCR_VECTKEY | ((uint32_t)IRQ_PRIGROUP << AIRCR_PRIGROUP_POS);
+
+    for (uint8_t i = 0u; i < IRQ_SRC_COUNT; i++)
+    {
+        const irq_plan_entry_t *e = &s_irq_plan[i];
+        uint8_t prio = IRQ_PRIO_BYTE(e->preempt, e->sub);
+
+        if (e->irqn >= 0) NVIC_IPR_BASE[e->irqn] = prio;
+        else              SCB_SHPR_BASE[SYSTICK_EXC_NUM - 4] = prio;
+    }
+
+#ifdef IRQ_PROFILE_MARKER
+    irq_marker_init();
+#endif
+}
+
+const irq_plan_entry_t *irq_plan_get(irq_source_t src)
+{
+    if (src >= IRQ_SRC_COUNT) return NULL;
+    return &s_irq_plan[src];
+}
+
+FAST_CODE void irq_profile_exit(irq_source_t src, uint32_t entry, uint32_t latency_cyc)
+{
+    uint32_t dur = cycles_now() - entry;
+    irq_profile_t *p = &s_profile[src];
+
+    p->count++;
+    p->dur_last_cyc = dur;
+    if (dur > p->dur_worst_cyc)         p->dur_worst_cyc = dur;
+    if (latency_cyc > p->lat_worst_cyc) p->lat_worst_cyc = latency_cyc;
+
+    irq_marker_exit();
+}
+
+void irq_profile_get(irq_source_t src, irq_profile_t *out)
+{
+    if (src >= IRQ_SRC_COUNT || out == NULL) return;
+
+    uint32_t primask = irq_save_all();     /* level-0 handlers profile too */
+    *out = s_profile[src];
+    irq_restore_all(primask);
+}
+
+void irq_profile_reset(void)
+{
+    uint32_t primask = irq_save_all();
+    for (uint8_t i = 0u; i < IRQ_SRC_COUNT; i++)
+    {
+        s_profile[i] = (irq_profile_t){0};
+    }
+    irq_restore_all(primask);
+}
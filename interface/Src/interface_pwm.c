@@ -1,5 +1,6 @@
 #include "interface/interface.h"
 #include "interface_defines.h"
+#include "interface_init.h"
 #include "driver_timer.h"
 #include "driver_gpio.h"
 #include "driver_clock.h"
@@ -32,8 +33,11 @@ static TIM_Config_t s_pwm0_cfg = {
     .period    = PWM0_PERIOD,
 };
 
+/* Once only: a second TIM_PWM_Init would drop the trip config in CCMR1/SMCR */
 static void pwm0_init(void)
 {
+    if (s_pwm0_init) return;
+
     GPIO_PinConfig_t pin = {
         .pGPIOx              = GPIOA,
         .GPIO_PinNumber      = GPIO_PIN_NO_5,
@@ -53,7 +57,7 @@ static void pwm0_init(void)
 
 static void pwm0_set_duty(float duty_percent)
 {
-    if (!s_pwm0_init) pwm0_init();
+    INTERFACE_LAZY_INIT(s_pwm0_init, pwm0_init);
     TIM_PWM_SetDuty(&s_pwm0_cfg, TIM_CHANNEL_1, duty_percent);
 }
 
@@ -103,4 +107,11 @@ void PWM_deinit(uint8_t instance_id)
 {
     const pwm_instance_t *p = pwm_dispatch(instance_id);
     if (p && p->deinit) p->deinit();
-}
\ No newline at end of file
+}
+
+#if defined(INTERFACE_PREINIT)
+void PWM_set_duty_fast(uint8_t instance_id, float duty_percent)
+{
+    s_pwm_table[instance_id].set_duty(duty_percent);
+}
+#endif
\ No newline at end of file
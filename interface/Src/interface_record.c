@@ -0,0 +1,119 @@
+#include "interface_record.h"
+#include "interface_timebase_us.h"
+#include "interface_irq.h"   /* UART RX events are appended from the ISR */
+#include "interface_fast.h"
+
+/* ------------------------------------------------------------------ */
+/*  State                                                             */
+/* ------------------------------------------------------------------ */
+
+static uint8_t           s_buf[RECORD_BUFFER_SIZE];
+static uint32_t          s_len = 0u;
+static uint32_t          s_last_us = 0u;
+static uint32_t          s_dropped = 0u;
+static volatile bool     s_active = false;
+
+static uint32_t          s_gpio_known = 0u;     /* bit per pin_id, tracked while idle too */
+static uint32_t          s_gpio_level = 0u;
+
+static void append(uint8_t type, uint8_t channel, uint16_t value)
+{
+    uint32_t primask = irq_save();
+
+    if (s_active)
+    {
+        if (s_len + RECORD_EVENT_MAX_SIZE > RECORD_BUFFER_SIZE)
+        {
+            s_dropped++;    /* keep the head of the capture intact */
+        }
+        else
+        {
+            uint32_t now = timebase_us_get32();
+            record_event_t ev = {
+                .type    = type,
+                .channel = channel,
+                .dt_us   = now - s_last_us,
+                .value   = value,
+            };
+            s_len    += record_encode(&s_buf[s_len], &ev);
+            s_last_us = now;
+        }
+    }
+
+    irq_restore(primask);
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+void record_start(void)
+{
+    uint32_t primask = irq_save();
+    s_len        = 0u;
+    s_dropped    = 0u;
+    s_last_us    = timebase_us_get32();
+    s_active     = true;
+    irq_restore(primask);
+
+    /* Seed replay with the levels the app last saw (pull-up button idles high) */
+    for (uint8_t pin = 0u; pin < 16u; pin++)
+    {
+        uint32_t bit = 1UL << pin;
+        if (s_gpio_known & bit)
+        {
+            append((s_gpio_level & bit) ? RECORD_GPIO_HIGH : RECORD_GPIO_LOW, pin, 0u);
+        }
+    }
+}
+
+void record_stop(void)
+{
+    s_active = false;
+}
+
+bool record_active(void)
+{
+    return s_active;
+}
+
+const uint8_t *record_data(uint32_t *len)
+{
+    if (len) *len = s_len;
+    return s_buf;
+}
+
+uint32_t record_dropped(void)
+{
+    return s_dropped;
+}
+
+/*
+ * record_gpio tracks levels on every IO_read_fast, so it stays in SRAM
+ * with its caller. record_uart_rx is only an early-out in front of
+ * append(), whose encoder and timebase calls live in flash anyway.
+ */
+void record_uart_rx(uint8_t channel, uint8_t byte)
+{
+    if (!s_active) return;
+    append(RECORD_UART_RX, channel, byte);
+}
+
+FAST_CODE void record_gpio(uint8_t pin_id, uint8_t level)
+{
+    if (pin_id >= 16u) return;
+
+    uint32_t bit = 1UL << pin_id;
+    uint32_t lvl = level ? bit : 0u;
+    if ((s_gpio_known & bit) && (s_gpio_level & bit) == lvl) return;
+
+    s_gpio_known |= bit;
+    s_gpio_level  = (s_gpio_level & ~bit) | lvl;
+    if (s_active) append(level ? RECORD_GPIO_HIGH : RECORD_GPIO_LOW, pin_id, 0u);
+}
+
+void record_adc(uint8_t channel, uint16_t sample)
+{
+    if (!s_active) return;
+    append(RECORD_ADC, channel, sample);
+}
@@ -1,25 +1,42 @@
 #include "interface/interface.h"
+#include "interface_init.h"
 #include "driver_systick.h"
 
 static uint8_t s_is_init = 0u;
 
-static void timebase_ensure_init(void)
+void timebase_init(void)
 {
-    if (!s_is_init)
+    systick_init(1000u);
+    s_is_init = 1u;
+}
+
+/* The 64-bit tick count is two loads; SysTick may fire between them */
+static uint64_t ticks_read(void)
+{
+    uint64_t a, b;
+    do
     {
-        systick_init(1000u);
-        s_is_init = 1u;
-    }
+        a = ticks_get();
+        b = ticks_get();
+    } while (a != b);
+    return a;
 }
 
 uint64_t timebase_get(void)
 {
-    timebase_ensure_init();
-    return ticks_get();
+    INTERFACE_LAZY_INIT(s_is_init, timebase_init);
+    return ticks_read();
 }
 
+#if defined(INTERFACE_PREINIT)
+uint64_t timebase_get_fast(void)
+{
+    return ticks_read();
+}
+#endif
+
 void timebase_deinit(void)
 {
     // todo
     s_is_init = 0u;
-}
\ No newline at end of file
+}
@@ -0,0 +1,244 @@
+#include "interface_trip.h"
+#include "interface/interface.h"
+#include "interface_defines.h"
+#include "interface_cycles.h"
+#include "interface_irq.h"
+#include "driver_gpio.h"
+#include "driver_adc.h"
+#include "driver_timer.h"
+#include "driver_interrupt.h"
+
+/* ------------------------------------------------------------------ */
+/*  Registers                                                         */
+/* ------------------------------------------------------------------ */
+
+#define ADC_SR_AWD          (1u << 0)
+#define ADC_CR1_AWDIE       (1u << 6)
+#define ADC_CR1_AWDSGL      (1u << 9)
+#define ADC_CR1_JAWDEN      (1u << 22)
+#define ADC_CR1_AWDEN       (1u << 23)
+#define ADC_CR1_AWDCH_MASK  0x1Fu
+#define ADC_AWD_CHANNEL     1u              /* PA1 - ADC1 CH1 */
+#define ADC_JSQR_JSQ4_POS   15u             /* the only slot when JL = 0 */
+#define ADC_CR2_JEXTSEL_POS 16u
+#define ADC_CR2_JEXTSEL_MASK (0xFu << ADC_CR2_JEXTSEL_POS)
+#define ADC_CR2_JEXTEN_MASK (3u << 20)
+#define ADC_CR2_JEXTEN_RISE (1u << 20)
+#define ADC_JEXTSEL_TIM2_TRGO 3u
+
+#define TIM_CCMR1_OC1M_POS      4u
+#define TIM_CCMR1_OC1M_MASK     (7u << TIM_CCMR1_OC1M_POS)
+#define TIM_CCMR1_OC1CE         (1u << 7)
+#define TIM_OCM_FORCE_INACTIVE  (4u << TIM_CCMR1_OC1M_POS)
+#define TIM_OCM_PWM1            (6u << TIM_CCMR1_OC1M_POS)
+#define TIM_SMCR_ETF_POS        8u
+#define TIM_SMCR_ETP            (1u << 15)
+#define TIM_ETR_FILTER          3u          /* fCK_INT, N=8 */
+#define TIM_CR2_MMS_MASK        (7u << 4)
+#define TIM_CR2_MMS_UPDATE      (2u << 4)   /* TRGO on update */
+
+#define TRIP_PWM_TIM            TIM2        /* PWM0 */
+
+typedef struct
+{
+    volatile uint32_t IMR;
+    volatile uint32_t EMR;
+    volatile uint32_t RTSR;
+    volatile uint32_t FTSR;
+    volatile uint32_t SWIER;
+    volatile uint32_t PR;
+} exti_regs_t;
+
+#define EXTI_REGS               ((exti_regs_t *)0x40013C00UL)
+#define SYSCFG_EXTICR1          (*(volatile uint32_t *)0x40013808UL)
+#define RCC_APB2ENR_SYSCFGEN    (1u << 14)
+#define EXTI_LINE0              (1u << 0)
+
+/* ------------------------------------------------------------------ */
+/*  State                                                             */
+/* ------------------------------------------------------------------ */
+
+static uint16_t               s_adc_threshold = TRIP_ADC_DISABLED;
+static bool                   s_use_comparator = false;
+
+static volatile bool          s_latched = false;
+static volatile bool          s_pending = false;
+static volatile uint32_t      s_trip_stamp = 0u;
+static trip_stats_t           s_stats;
+
+/* Shared tail of both trip ISRs — output first, bookkeeping after */
+static void trip_latch(uint32_t entry, trip_source_t source)
+{
+    TRIP_PWM_TIM->CCMR1 = (TRIP_PWM_TIM->CCMR1 & ~TIM_CCMR1_OC1M_MASK) | TIM_OCM_FORCE_INACTIVE;
+    uint32_t now = cycles_now();
+
+    if (s_latched) return;
+    s_latched    = true;
+    s_pending    = true;
+    s_trip_stamp = now;
+
+    s_stats.count++;
+    s_stats.last_source    = source;
+    s_stats.react_last_cyc = now - entry;
+    if (s_stats.react_last_cyc > s_stats.react_worst_cyc)
+    {
+        s_stats.react_worst_cyc = s_stats.react_last_cyc;
+    }
+}
+
+/* Timer side of the comparator path; lost if TIM2 is re-initialised */
+static void comparator_apply(void)
+{
+    TRIP_PWM_TIM->SMCR  = (TRIP_PWM_TIM->SMCR & ~(0xFu << TIM_SMCR_ETF_POS))
+                        | (TIM_ETR_FILTER << TIM_SMCR_ETF_POS) | TIM_SMCR_ETP;
+    TRIP_PWM_TIM->CCMR1 |= TIM_CCMR1_OC1CE;
+}
+
+/*
+ * Watchdog window and enables; lost if ADC1 is re-initialised.
+ *
+ * The watchdog only sees conversions, so CH1 is also the injected group,
+ * started by TIM2's update. PWM0 runs on TIM2, so CH1 is checked once per
+ * PWM period whenever the output is enabled, with or without the stream
+ * or the control loop. Injected conversions slip in between regular ones
+ * and leave SQR3 and DR to those users.
+ */
+static void awd_apply(void)
+{
+    ADC1->HTR  = s_adc_threshold;
+    ADC1->LTR  = 0u;
+    ADC1->JSQR = ADC_AWD_CHANNEL << ADC_JSQR_JSQ4_POS;
+    ADC1->CR1  = (ADC1->CR1 & ~ADC_CR1_AWDCH_MASK)
+               | ADC_AWD_CHANNEL | ADC_CR1_AWDSGL | ADC_CR1_AWDEN | ADC_CR1_JAWDEN | ADC_CR1_AWDIE;
+    ADC1->CR2  = (ADC1->CR2 & ~(ADC_CR2_JEXTSEL_MASK | ADC_CR2_JEXTEN_MASK))
+               | (ADC_JEXTSEL_TIM2_TRGO << ADC_CR2_JEXTSEL_POS) | ADC_CR2_JEXTEN_RISE;
+
+    TRIP_PWM_TIM->CR2 = (TRIP_PWM_TIM->CR2 & ~TIM_CR2_MMS_MASK) | TIM_CR2_MMS_UPDATE;
+}
+
+static void comparator_init(void)
+{
+    /* PA0 keeps its pull-up; IDR still reads it for the button BSP */
+    GPIO_PinConfig_t pin = {
+        .pGPIOx              = GPIOA,
+        .GPIO_PinNumber      = GPIO_PIN_NO_0,
+        .GPIO_PinMode        = GPIO_MODE_ALTFN,
+        .GPIO_PinSpeed       = GPIO_SPEED_HIGH,
+        .GPIO_PinOPType      = GPIO_OP_TYPE_PP,
+        .GPIO_PinPuPdControl = GPIO_PIN_PU,
+        .GPIO_PinAltFunMode  = GPIO_PIN_ALTFN_1,     /* TIM2_ETR */
+    };
+    GPIO_Init(&pin);
+    comparator_apply();
+
+    RCC->APB2ENR   |= RCC_APB2ENR_SYSCFGEN;
+    SYSCFG_EXTICR1 &= ~0xFu;                        /* EXTI0 <- PA0 */
+    EXTI_REGS->FTSR |= EXTI_LINE0;
+    EXTI_REGS->PR    = EXTI_LINE0;
+    EXTI_REGS->IMR  |= EXTI_LINE0;
+    interrupt_Config(IRQ_NO_EXTI0, ENABLE);
+}
+
+static void awd_init(void)
+{
+    analog_init(INTERFACE_ADC_0);
+
+    ADC1->SR = ~ADC_SR_AWD;
+    awd_apply();
+    interrupt_Config(IRQ_NO_ADC, ENABLE);
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+void trip_init(uint16_t adc_threshold, bool use_comparator)
+{
+    PWM_init(INTERFACE_PWM_0);      /* no-op if boot brought it up */
+
+    s_adc_threshold  = adc_threshold;
+    s_use_comparator = use_comparator;
+
+    if (adc_threshold != TRIP_ADC_DISABLED) awd_init();
+    if (use_comparator) comparator_init();
+}
+
+void trip_reapply(void)
+{
+    uint32_t primask = irq_save_all();     /* shared with the level-0 trip ISRs */
+    if (s_adc_threshold != TRIP_ADC_DISABLED) awd_apply();
+    if (s_use_comparator) comparator_apply();
+    if (s_latched)
+    {
+        TRIP_PWM_TIM->CCMR1 = (TRIP_PWM_TIM->CCMR1 & ~TIM_CCMR1_OC1M_MASK) | TIM_OCM_FORCE_INACTIVE;
+    }
+    irq_restore_all(primask);
+}
+
+bool trip_take(trip_source_t *source)
+{
+    if (!s_pending) return false;
+
+    uint32_t primask = irq_save_all();
+    s_pending = false;
+    s_stats.post_last_cyc = cycles_now() - s_trip_stamp;
+    if (s_stats.post_last_cyc > s_stats.post_worst_cyc)
+    {
+        s_stats.post_worst_cyc = s_stats.post_last_cyc;
+    }
+    if (source) *source = s_stats.last_source;
+    irq_restore_all(primask);
+    return true;
+}
+
+bool trip_latched(void)
+{
+    return s_latched;
+}
+
+void trip_rearm(void)
+{
+    uint32_t primask = irq_save_all();
+    s_latched = false;
+    s_pending = false;
+    TRIP_PWM_TIM->CCMR1 = (TRIP_PWM_TIM->CCMR1 & ~TIM_CCMR1_OC1M_MASK) | TIM_OCM_PWM1;
+    irq_restore_all(primask);
+}
+
+void trip_stats(trip_stats_t *out)
+{
+    if (out == NULL) return;
+    uint32_t primask = irq_save_all();
+    *out = s_stats;
+    irq_restore_all(primask);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Trip ISRs                                                         */
+/* ------------------------------------------------------------------ */
+
+void ADC_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+
+    if (ADC1->SR & ADC_SR_AWD)
+    {
+        trip_latch(entry, TRIP_SRC_ADC_AWD);
+        ADC1->SR = ~ADC_SR_AWD;
+    }
+
+    irq_profile_exit(IRQ_SRC_ADC, entry, 0u);
+}
+
+void EXTI0_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+
+    if (EXTI_REGS->PR & EXTI_LINE0)
+    {
+        trip_latch(entry, TRIP_SRC_COMPARATOR);
+        EXTI_REGS->PR = EXTI_LINE0;
+    }
+
+    irq_profile_exit(IRQ_SRC_EXTI0, entry, 0u);
+}
@@ -0,0 +1,62 @@
+#include "interface_watchdog.h"
+
+/* ------------------------------------------------------------------ */
+/*  IWDG registers                                                    */
+/* ------------------------------------------------------------------ */
+
+typedef struct
+{
+    volatile uint32_t KR;
+    volatile uint32_t PR;
+    volatile uint32_t RLR;
+    volatile uint32_t SR;
+} iwdg_regs_t;
+
+#define IWDG_REGS           ((iwdg_regs_t *)0x40003000UL)
+
+#define IWDG_KEY_RELOAD     0xAAAAu
+#define IWDG_KEY_UNLOCK     0x5555u
+#define IWDG_KEY_START      0xCCCCu
+
+#define IWDG_SR_PVU         (1u << 0)
+#define IWDG_SR_RVU         (1u << 1)
+
+#define IWDG_LSI_HZ         32000u
+#define IWDG_RELOAD_MAX     0x0FFFu
+#define IWDG_PR_MAX         6u          /* /256 */
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+uint32_t watchdog_init(uint32_t timeout_ms)
+{
+    if (timeout_ms == 0u) timeout_ms = 1u;
+    if (timeout_ms > WATCHDOG_MAX_TIMEOUT_MS) timeout_ms = WATCHDOG_MAX_TIMEOUT_MS;
+
+    uint8_t  pr = 0u;
+    uint32_t reload;
+    for (;;)
+    {
+        uint32_t div = 4u << pr;
+        reload = (timeout_ms * (IWDG_LSI_HZ / 1000u)) / div;
+        if (reload <= IWDG_RELOAD_MAX || pr == IWDG_PR_MAX) break;
+        pr++;
+    }
+    if (reload == 0u) reload = 1u;
+    if (reload > IWDG_RELOAD_MAX) reload = IWDG_RELOAD_MAX;
+
+    IWDG_REGS->KR = IWDG_KEY_START;
+    IWDG_REGS->KR = IWDG_KEY_UNLOCK;
+    IWDG_REGS->PR  = pr;
+    IWDG_REGS->RLR = reload;
+    while (IWDG_REGS->SR & (IWDG_SR_PVU | IWDG_SR_RVU));
+    IWDG_REGS->KR = IWDG_KEY_RELOAD;
+
+    return (reload * (4u << pr)) / (IWDG_LSI_HZ / 1000u);
+}
+
+void watchdog_feed(void)
+{
+    IWDG_REGS->KR = IWDG_KEY_RELOAD;
+}
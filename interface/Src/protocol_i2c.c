@@ -1,4 +1,5 @@
 #include "interface/interface.h"
+#include "interface_init.h"
 #include "driver_i2c.h"
 #include "driver_gpio.h"
 
@@ -38,7 +39,7 @@ void i2c1_protocol_init(void)
 
 void i2c1_protocol_send(uint8_t *data, uint32_t Len)
 {
-    if(!i2c1_is_init) i2c1_protocol_init();
+    INTERFACE_LAZY_INIT(i2c1_is_init, i2c1_protocol_init);
 
     if(Len == 0) return;
 
@@ -58,7 +59,7 @@ void i2c1_protocol_send(uint8_t *data, uint32_t Len)
 
 uint8_t i2c1_protocol_receive(uint8_t *buffer, uint32_t Len)
 {
-    if(!i2c1_is_init) i2c1_protocol_init();
+    INTERFACE_LAZY_INIT(i2c1_is_init, i2c1_protocol_init);
 
     if(Len == 0)
     {
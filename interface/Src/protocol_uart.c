@@ -1,4 +1,10 @@
 #include "interface/interface.h"
+#include "interface_init.h"
+#include "interface_comm.h"
+#include "interface_record.h"
+#include "interface_irq.h"
+#include "interface_fast.h"
+#include "interface_defines.h"
 #include "shared/ring-buffer.h"
 #include "driver_uart.h"
 #include "driver_gpio.h"
@@ -55,13 +61,23 @@ void uart2_protocol_init(void)
 
 void uart2_protocol_send(uint8_t *data, uint32_t Len)
 {
-    if(!uart2_is_init) uart2_protocol_init();
+    INTERFACE_LAZY_INIT(uart2_is_init, uart2_protocol_init);
     UART_Write(UART2, data, Len);
 }
 
+void uart2_protocol_sendv(const comm_iovec_t *iov, uint8_t count)
+{
+    INTERFACE_LAZY_INIT(uart2_is_init, uart2_protocol_init);
+    for(uint8_t i = 0; i < count; i++)
+    {
+        if(iov[i].len == 0) continue;
+        UART_Write(UART2, (uint8_t *)iov[i].base, iov[i].len);
+    }
+}
+
 uint8_t uart2_protocol_receive(uint8_t *buffer, uint32_t Len)
 {
-    if(!uart2_is_init) uart2_protocol_init();
+    INTERFACE_LAZY_INIT(uart2_is_init, uart2_protocol_init);
 
     if(Len == 0)
     {
@@ -78,18 +94,21 @@ uint8_t uart2_protocol_receive(uint8_t *buffer, uint32_t Len)
 
 uint8_t uart2_protocol_data_available(void)
 {
-    if(!uart2_is_init) uart2_protocol_init();
+    INTERFACE_LAZY_INIT(uart2_is_init, uart2_protocol_init);
     return !ring_buffer_empty(&rb_uart2);
 }
 
-void USART2_IRQHandler(void)
+/* Runs from SRAM with the ring buffer; DR is read directly, not via the flash-resident driver */
+FAST_CODE void USART2_IRQHandler(void)
 {
-    uint32_t sr = UART2->SR;
+    uint32_t entry = irq_profile_enter();
+    uint32_t sr    = UART2->SR;
 
     if(sr & UART_FLAG_RXNE)
     {
-        uint8_t data = UART_ReadByte(UART2);
+        uint8_t data = (uint8_t)UART2->DR;
         ring_buffer_write(&rb_uart2, data);
+        record_uart_rx(INTERFACE_PROTOCOL_UART2, data);
     }
 
     if(sr & (1 << UART_SR_ORE))
@@ -97,4 +116,6 @@ void USART2_IRQHandler(void)
         /* Clear ORE by reading SR then DR (per reference manual) */
         (void)UART2->DR;
     }
+
+    irq_profile_exit(IRQ_SRC_USART2, entry, 0u);
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "interface_record.h"
+
+#include <stddef.h>
+
+uint32_t record_encode(uint8_t *out, const record_event_t *ev)
+{
+    uint32_t n  = 0u;
+    uint32_t dt = ev->dt_us;
+
+    out[n++] = (uint8_t)((ev->type << 4) | (ev->channel & 0x0Fu));
+    while (dt >= 0x80u)
+    {
+        out[n++] = (uint8_t)(dt | 0x80u);
+        dt >>= 7;
+    }
+    out[n++] = (uint8_t)dt;
+
+    switch (ev->type)
+    {
+        case RECORD_UART_RX:
+            out[n++] = (uint8_t)ev->value;
+            break;
+        case RECORD_ADC:
+            out[n++] = (uint8_t)(ev->value);
+            out[n++] = (uint8_t)(ev->value >> 8);
+            break;
+        default:
+            break;
+    }
+    return n;
+}
+
+uint32_t record_decode(const uint8_t *in, uint32_t len, record_event_t *ev)
+{
+    if (in == NULL || ev == NULL || len < 2u) return 0u;
+
+    uint32_t n = 0u;
+    ev->type    = in[n] >> 4;
+    ev->channel = in[n] & 0x0Fu;
+    ev->value   = 0u;
+    ev->dt_us   = 0u;
+    n++;
+
+    for (uint8_t shift = 0u; ; shift += 7u)
+    {
+        if (n >= len || shift > 28u) return 0u;
+        uint8_t b = in[n++];
+        ev->dt_us |= (uint32_t)(b & 0x7Fu) << shift;
+        if (!(b & 0x80u)) break;
+    }
+
+    switch (ev->type)
+    {
+        case RECORD_UART_RX:
+            if (n + 1u > len) return 0u;
+            ev->value = in[n++];
+            break;
+        case RECORD_GPIO_LOW:
+            break;
+        case RECORD_GPIO_HIGH:
+            ev->value = 1u;
+            break;
+        case RECORD_ADC:
+            if (n + 2u > len) return 0u;
+            ev->value = (uint16_t)(in[n] | (in[n + 1u] << 8));
+            n += 2u;
+            break;
+        default:
+            return 0u;
+    }
+    return n;
+}
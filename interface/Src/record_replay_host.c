@@ -0,0 +1,234 @@
+/**
+ * @file record_replay_host.c
+ * @brief Host implementation of interface.h driven by a recorded log
+ *
+ * Built into interface_host (BUILD_TESTS). Outputs are accepted and
+ * discarded (or echoed for comm), inputs come from the log, and time is
+ * the virtual clock from timebase_us_host.c.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "interface/interface.h"
+#include "interface_record.h"
+#include "interface_timebase_us.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define REPLAY_MAX_PINS     16u
+#define REPLAY_MAX_ADC      16u
+#define REPLAY_RX_SIZE      256u    /* power of two */
+
+static const uint8_t *s_log = NULL;
+static uint32_t       s_log_len = 0u;
+
+static uint8_t        s_pin_level[REPLAY_MAX_PINS];
+static uint16_t       s_adc_value[REPLAY_MAX_ADC];
+
+static uint8_t        s_rx[REPLAY_RX_SIZE];
+static uint32_t       s_rx_head = 0u;
+static uint32_t       s_rx_tail = 0u;
+
+static bool           s_echo_tx = false;
+static uint32_t       s_tx_bytes = 0u;
+
+static uint64_t host_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void inject(const record_event_t *ev)
+{
+    switch (ev->type)
+    {
+        case RECORD_UART_RX:
+            if (s_rx_head - s_rx_tail < REPLAY_RX_SIZE)
+            {
+                s_rx[s_rx_head++ & (REPLAY_RX_SIZE - 1u)] = (uint8_t)ev->value;
+            }
+            break;
+        case RECORD_GPIO_LOW:
+        case RECORD_GPIO_HIGH:
+            s_pin_level[ev->channel] = (uint8_t)ev->value;
+            break;
+        case RECORD_ADC:
+            s_adc_value[ev->channel] = ev->value;
+            break;
+        default:
+            break;
+    }
+}
+
+/* ================================================================== */
+/*  Replay driver                                                     */
+/* ================================================================== */
+
+void replay_load(const uint8_t *log, uint32_t len)
+{
+    s_log     = log;
+    s_log_len = len;
+    s_rx_head = s_rx_tail = 0u;
+    s_tx_bytes = 0u;
+    memset(s_pin_level, 0, sizeof(s_pin_level));    /* log opens with the recorded levels */
+    memset(s_adc_value, 0, sizeof(s_adc_value));
+    timebase_us_init();
+}
+
+void replay_echo_tx(bool enable)
+{
+    s_echo_tx = enable;
+}
+
+bool replay_run(void (*step)(void), uint32_t idle_step_us, replay_report_t *report)
+{
+    if (step == NULL || report == NULL || idle_step_us == 0u) return false;
+    memset(report, 0, sizeof(*report));
+
+    uint64_t now = 0u;
+    uint32_t pos = 0u;
+    record_event_t ev;
+
+    while (pos < s_log_len)
+    {
+        uint32_t used = record_decode(&s_log[pos], s_log_len - pos, &ev);
+        if (used == 0u) return false;
+        pos += used;
+
+        uint64_t target = now + ev.dt_us;
+        while (now + idle_step_us < target)
+        {
+            now += idle_step_us;
+            timebase_us_host_set(now);
+            step();
+            report->steps++;
+        }
+        now = target;
+        timebase_us_host_set(now);
+        inject(&ev);
+
+        uint64_t t0 = host_ns();
+        step();
+        uint32_t ns = (uint32_t)(host_ns() - t0);
+
+        uint32_t gap_us = ev.dt_us ? ev.dt_us : 1u;
+        uint32_t ppm    = (uint32_t)(((uint64_t)ns * 1000u) / gap_us);
+
+        report->events++;
+        report->steps++;
+        report->busy_ns += ns;
+        if (ns > report->worst_ns)
+        {
+            report->worst_ns   = ns;
+            report->worst_type = ev.type;
+        }
+        if (ppm > report->worst_budget_ppm) report->worst_budget_ppm = ppm;
+    }
+
+    report->span_us  = now;
+    report->tx_bytes = s_tx_bytes;
+    return true;
+}
+
+/* ================================================================== */
+/*  interface.h — host implementation                                 */
+/* ================================================================== */
+
+io_status_t IO_init(uint8_t pin_id)
+{
+    return (pin_id < REPLAY_MAX_PINS) ? IO_OK : IO_ERR_INVALID_PIN;
+}
+
+io_status_t IO_write(uint8_t pin_id, uint8_t value)
+{
+    return (pin_id < REPLAY_MAX_PINS) ? IO_OK : IO_ERR_INVALID_PIN;
+}
+
+io_status_t IO_read(uint8_t pin_id, uint8_t *out_value)
+{
+    if (out_value == NULL) return IO_ERR_NULL;
+    if (pin_id >= REPLAY_MAX_PINS) return IO_ERR_INVALID_PIN;
+    *out_value = s_pin_level[pin_id];
+    return IO_OK;
+}
+
+io_status_t IO_toggle(uint8_t pin_id)
+{
+    return (pin_id < REPLAY_MAX_PINS) ? IO_OK : IO_ERR_INVALID_PIN;
+}
+
+io_status_t IO_configure(uint8_t pin_id, uint8_t option, uint8_t value)
+{
+    return (pin_id < REPLAY_MAX_PINS) ? IO_OK : IO_ERR_INVALID_PIN;
+}
+
+io_status_t IO_deinit(uint8_t pin_id)
+{
+    return (pin_id < REPLAY_MAX_PINS) ? IO_OK : IO_ERR_INVALID_PIN;
+}
+
+void analog_init(uint8_t channel_id)
+{
+}
+
+uint16_t analog_read(uint8_t channel_id)
+{
+    return (channel_id < REPLAY_MAX_ADC) ? s_adc_value[channel_id] : 0u;
+}
+
+void analog_deinit(uint8_t channel_id)
+{
+}
+
+void PWM_init(uint8_t instance_id)
+{
+}
+
+void PWM_set_duty(uint8_t instance_id, float duty_percent)
+{
+}
+
+void PWM_deinit(uint8_t instance_id)
+{
+}
+
+void comm_init(uint8_t comm_id)
+{
+}
+
+void comm_send(uint8_t comm_id, uint8_t *buf, uint32_t len)
+{
+    s_tx_bytes += len;
+    if (s_echo_tx) fwrite(buf, 1u, len, stdout);
+}
+
+uint8_t comm_receive(uint8_t comm_id, uint8_t *buf, uint32_t len)
+{
+    uint8_t n = 0u;
+    while (n < len && s_rx_tail != s_rx_head)
+    {
+        buf[n++] = s_rx[s_rx_tail++ & (REPLAY_RX_SIZE - 1u)];
+    }
+    return n;
+}
+
+uint8_t comm_data_available(uint8_t comm_id)
+{
+    return s_rx_head != s_rx_tail;
+}
+
+void comm_deinit(uint8_t comm_id)
+{
+}
+
+uint64_t timebase_get(void)
+{
+    return timebase_us_get() / 1000u;
+}
+
+void timebase_deinit(void)
+{
+}
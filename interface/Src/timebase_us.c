@@ -0,0 +1,110 @@
+#include "interface_timebase_us.h"
+#include "interface_cycles.h"
+#include "interface_irq.h"
+#include "driver_timer.h"
+#include "driver_interrupt.h"
+
+/* ------------------------------------------------------------------ */
+/*  TIM5 — 32-bit, 1 MHz, update IRQ on wrap                          */
+/* ------------------------------------------------------------------ */
+
+#define TIM_CR1_CEN     (1u << 0)
+#define TIM_DIER_UIE    (1u << 0)
+#define TIM_SR_UIF      (1u << 0)
+#define TIM_EGR_UG      (1u << 0)
+
+#define RCC_APB1ENR_TIM5EN  (1u << 3)
+
+static inline uint32_t ipsr_read(void)
+{
+    uint32_t ipsr;
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+    return ipsr;
+}
+
+static volatile uint32_t s_seq      = 0u;   /* odd while the ISR is updating */
+static volatile uint32_t s_overflow = 0u;
+static uint64_t          s_wall_offset = 0u;
+
+void timebase_us_init(void)
+{
+    RCC->APB1ENR |= RCC_APB1ENR_TIM5EN;
+
+    TIM5->CR1  = 0u;
+    TIM5->PSC  = (cycles_core_hz() / 1000000u) - 1u;
+    TIM5->ARR  = 0xFFFFFFFFu;
+    TIM5->CNT  = 0u;
+    TIM5->EGR  = TIM_EGR_UG;        /* latch PSC */
+    TIM5->SR   = 0u;
+    TIM5->DIER = TIM_DIER_UIE;
+
+    s_seq      = 0u;
+    s_overflow = 0u;
+
+    interrupt_Config(IRQ_NO_TIM5, ENABLE);
+    TIM5->CR1 = TIM_CR1_CEN;
+}
+
+uint64_t timebase_us_get(void)
+{
+    uint32_t seq, hi, lo, pending;
+
+#ifndef NDEBUG
+    /* thread context only: an ISR that preempted TIM5_IRQHandler mid-update would spin forever */
+    if (ipsr_read() != 0u) __asm volatile ("bkpt #0");
+#endif
+
+    do
+    {
+        seq     = s_seq;
+        hi      = s_overflow;
+        lo      = TIM5->CNT;
+        pending = TIM5->SR & TIM_SR_UIF;
+    } while ((seq & 1u) || seq != s_seq);
+
+    /*
+     * Thread-mode reader: the seq loop retries across an overflow update.
+     * CNT can still have wrapped with the update not yet run, when the
+     * caller holds irq_save() or the wrap landed after the seq check;
+     * a pending UIF with a small CNT means count that wrap here.
+     */
+    if (pending && lo < 0x80000000u) hi++;
+
+    return ((uint64_t)hi << 32) | lo;
+}
+
+uint32_t timebase_us_get32(void)
+{
+    return TIM5->CNT;
+}
+
+void timebase_us_sync(const RTC_DateTime_t *now)
+{
+    s_wall_offset = timebase_us_from_datetime(now) - timebase_us_get();
+}
+
+void timebase_us_now(RTC_DateTime_t *out)
+{
+    timebase_us_to_datetime(timebase_us_get() + s_wall_offset, out);
+}
+
+void TIM5_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+    uint32_t lat   = irq_timer_latency(TIM5->CNT, TIM5->PSC);
+
+    /*
+     * seq goes odd before UIF clears: a reader that sees UIF already
+     * cleared but s_overflow not yet bumped must also see the odd seq
+     * and retry, or it would return a time 2^32 us too low.
+     */
+    if (TIM5->SR & TIM_SR_UIF)
+    {
+        s_seq++;
+        TIM5->SR = ~TIM_SR_UIF;
+        s_overflow++;
+        s_seq++;
+    }
+
+    irq_profile_exit(IRQ_SRC_TIM5, entry, lat);
+}
@@ -0,0 +1,79 @@
+#include "interface_timebase_us.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/*  Civil date <-> day count (Gregorian, valid for RTC years 0-99)    */
+/* ------------------------------------------------------------------ */
+
+static const uint16_t s_days_before_month[12] = {
+    0u, 31u, 59u, 90u, 120u, 151u, 181u, 212u, 243u, 273u, 304u, 334u
+};
+
+static uint8_t is_leap(uint32_t year)
+{
+    return (year % 4u == 0u) ? 1u : 0u;     /* 2000-2099 */
+}
+
+static uint32_t days_from_date(uint32_t year, uint32_t month, uint32_t day)
+{
+    uint32_t days = year * 365u + (year + 3u) / 4u;
+    days += s_days_before_month[month - 1u];
+    if (month > 2u && is_leap(year)) days++;
+    return days + day - 1u;
+}
+
+/* ================================================================== */
+/*  Public functions                                                  */
+/* ================================================================== */
+
+uint64_t timebase_us_from_datetime(const RTC_DateTime_t *dt)
+{
+    if (dt == NULL) return 0u;
+
+    uint32_t month = (dt->date.month >= 1u && dt->date.month <= 12u) ? dt->date.month : 1u;
+    uint32_t day   = (dt->date.date  >= 1u) ? dt->date.date : 1u;
+
+    uint64_t secs = (uint64_t)days_from_date(dt->date.year, month, day) * 86400ULL;
+    secs += (uint64_t)dt->time.hours * 3600ULL;
+    secs += (uint64_t)dt->time.minutes * 60ULL;
+    secs += dt->time.seconds;
+    return secs * TIMEBASE_US_PER_SEC;
+}
+
+void timebase_us_to_datetime(uint64_t us, RTC_DateTime_t *out)
+{
+    if (out == NULL) return;
+    memset(out, 0, sizeof(*out));
+
+    uint64_t secs = us / TIMEBASE_US_PER_SEC;
+    uint32_t days = (uint32_t)(secs / 86400ULL);
+    uint32_t rem  = (uint32_t)(secs % 86400ULL);
+
+    out->time.hours   = (uint8_t)(rem / 3600u);
+    out->time.minutes = (uint8_t)((rem / 60u) % 60u);
+    out->time.seconds = (uint8_t)(rem % 60u);
+
+    uint32_t year = 0u;
+    while (days >= 365u + is_leap(year))
+    {
+        days -= 365u + is_leap(year);
+        year++;
+    }
+
+    uint32_t month = 12u;
+    while (month > 1u)
+    {
+        uint32_t start = s_days_before_month[month - 1u] + ((month > 2u) ? is_leap(year) : 0u);
+        if (days >= start)
+        {
+            days -= start;
+            break;
+        }
+        month--;
+    }
+
+    out->date.year  = (uint8_t)year;
+    out->date.month = (uint8_t)month;
+    out->date.date  = (uint8_t)(days + 1u);
+}
@@ -0,0 +1,48 @@
+/**
+ * @file timebase_us_host.c
+ * @brief Host backend for interface_timebase_us.h — virtual time
+ *
+ * Built into interface_host (BUILD_TESTS) with INTERFACE_HOST defined.
+ * Time only moves when the test calls timebase_us_host_set/advance().
+ */
+
+#include "interface_timebase_us.h"
+
+static uint64_t s_now_us = 0u;
+static uint64_t s_wall_offset = 0u;
+
+void timebase_us_init(void)
+{
+    s_now_us      = 0u;
+    s_wall_offset = 0u;
+}
+
+uint64_t timebase_us_get(void)
+{
+    return s_now_us;
+}
+
+uint32_t timebase_us_get32(void)
+{
+    return (uint32_t)s_now_us;
+}
+
+void timebase_us_sync(const RTC_DateTime_t *now)
+{
+    s_wall_offset = timebase_us_from_datetime(now) - s_now_us;
+}
+
+void timebase_us_now(RTC_DateTime_t *out)
+{
+    timebase_us_to_datetime(s_now_us + s_wall_offset, out);
+}
+
+void timebase_us_host_set(uint64_t us)
+{
+    s_now_us = us;
+}
+
+void timebase_us_host_advance(uint64_t us)
+{
+    s_now_us += us;
+}
@@ -0,0 +1,648 @@
+#include "interface_usb.h"
+#include "usb_hw.h"
+#include "interface_init.h"
+#include "interface_irq.h"
+#include "interface_timebase_us.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/*  USB 2.0 chapter 9 / CDC 1.2 constants                             */
+/* ------------------------------------------------------------------ */
+
+#define REQ_TYPE_MASK           0x60u
+#define REQ_TYPE_STANDARD       0x00u
+#define REQ_TYPE_CLASS          0x20u
+#define REQ_RECIP_MASK          0x1Fu
+#define REQ_RECIP_ENDPOINT      0x02u
+
+#define FEATURE_ENDPOINT_HALT   0x00u
+
+#define REQ_GET_STATUS          0x00u
+#define REQ_CLEAR_FEATURE       0x01u
+#define REQ_SET_FEATURE         0x03u
+#define REQ_SET_ADDRESS         0x05u
+#define REQ_GET_DESCRIPTOR      0x06u
+#define REQ_GET_CONFIGURATION   0x08u
+#define REQ_SET_CONFIGURATION   0x09u
+#define REQ_GET_INTERFACE       0x0Au
+#define REQ_SET_INTERFACE       0x0Bu
+
+#define CDC_SET_LINE_CODING         0x20u
+#define CDC_GET_LINE_CODING         0x21u
+#define CDC_SET_CONTROL_LINE_STATE  0x22u
+#define CDC_SEND_BREAK              0x23u
+#define CDC_LINE_CODING_SIZE        7u
+#define CDC_CONTROL_DTR             (1u << 0)
+
+#define DESC_DEVICE             1u
+#define DESC_CONFIG             2u
+#define DESC_STRING             3u
+
+#define EP0_SIZE                64u
+#define NOTIFY_PACKET           8u
+#define STRING_MAX_CHARS        31u
+#define RX_NONE                 0xFFu
+
+#define USB_VID                 0x0483u     /* ST — Virtual COM Port PID */
+#define USB_PID                 0x5740u
+
+/* ------------------------------------------------------------------ */
+/*  Descriptors                                                       */
+/* ------------------------------------------------------------------ */
+
+static const uint8_t s_device_desc[18] = {
+    18, DESC_DEVICE,
+    0x00, 0x02,                         /* USB 2.0 */
+    0x02, 0x00, 0x00,                   /* class CDC, defined per interface */
+    EP0_SIZE,
+    USB_VID & 0xFFu, USB_VID >> 8,
+    USB_PID & 0xFFu, USB_PID >> 8,
+    0x00, 0x01,                         /* device release 1.00 */
+    1, 2, 3,                            /* manufacturer, product, serial */
+    1                                   /* configurations */
+};
+
+static const uint8_t s_config_desc[67] = {
+    /* configuration: 2 interfaces, bus powered, 100 mA */
+    9, DESC_CONFIG, 67, 0, 2, 1, 0, 0x80, 50,
+
+    /* interface 0: CDC communications, ACM */
+    9, 4, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+    5, 0x24, 0x00, 0x10, 0x01,          /* header, CDC 1.10 */
+    5, 0x24, 0x01, 0x00, 0x01,          /* call management: data on interface 1 */
+    4, 0x24, 0x02, 0x02,                /* ACM: line coding + control line state */
+    5, 0x24, 0x06, 0x00, 0x01,          /* union: master 0, slave 1 */
+    7, 5, USB_CDC_EP_NOTIFY, USB_EP_TYPE_INTR, NOTIFY_PACKET, 0, 16,
+
+    /* interface 1: CDC data */
+    9, 4, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+    7, 5, USB_CDC_EP_DATA_OUT, USB_EP_TYPE_BULK, USB_CDC_PACKET, 0, 0,
+    7, 5, USB_CDC_EP_DATA_IN,  USB_EP_TYPE_BULK, USB_CDC_PACKET, 0, 0,
+};
+
+static const char *const s_strings[] = {
+    [1] = "F411 Sandbox",
+    [2] = "F411 Sandbox CDC",
+};
+
+/* ------------------------------------------------------------------ */
+/*  State                                                             */
+/* ------------------------------------------------------------------ */
+
+typedef struct
+{
+    const uint8_t *data;
+    uint16_t       remaining;
+    bool           in_active;       /* IN data stage in progress */
+    bool           zlp;             /* data shorter than wLength ends on a full packet */
+    bool           out_pending;     /* SET_LINE_CODING data stage expected */
+} ep0_state_t;
+
+static uint8_t               s_usb_is_init = 0u;
+static bool                  s_usb_ok = false;
+static ep0_state_t           s_ep0;
+static uint32_t              s_ep0_out[EP0_SIZE / 4u];
+static uint8_t               s_ep0_reply[EP0_SIZE];
+static volatile bool         s_configured = false;
+static volatile bool         s_suspended = false;
+static volatile bool         s_dtr = false;
+static uint8_t               s_config_value = 0u;
+static usb_cdc_line_coding_t s_line = { 115200u, 0u, 0u, 8u };
+static usb_cdc_stats_t       s_stats;
+
+/* IN: application fills s_tx_fill while the other buffer is on the endpoint */
+static uint32_t              s_tx_buf[2][USB_CDC_PACKET / 4u];
+static volatile uint16_t     s_tx_len[2];
+static volatile uint8_t      s_tx_fill = 0u;
+static volatile bool         s_tx_busy = false;
+static volatile bool         s_tx_stalled = false;  /* timed out; drop until the host reads */
+static volatile uint16_t     s_tx_inflight = 0u;
+
+/* OUT: controller fills s_rx_armed while the application drains s_rx_read */
+static uint32_t              s_rx_buf[2][USB_CDC_PACKET / 4u];
+static volatile uint16_t     s_rx_len[2];
+static volatile uint8_t      s_rx_armed = RX_NONE;
+static uint8_t               s_rx_read = 0u;
+static uint16_t              s_rx_pos = 0u;
+
+/* ------------------------------------------------------------------ */
+/*  Data endpoints                                                    */
+/* ------------------------------------------------------------------ */
+
+static bool host_ready(void)
+{
+    return s_configured && !s_suspended && s_dtr;
+}
+
+/* IRQs masked or ISR context */
+static void tx_kick(void)
+{
+    uint8_t  b   = s_tx_fill;
+    uint16_t len = s_tx_len[b];
+
+    if (len == 0u)
+    {
+        /* a full last packet leaves the host waiting for more — end the transfer */
+        if (s_tx_inflight == USB_CDC_PACKET)
+        {
+            s_tx_busy     = true;
+            s_tx_inflight = 0u;
+            usb_hw_ep_write(USB_CDC_EP_DATA_IN, NULL, 0u);
+        }
+        return;
+    }
+
+    s_tx_fill          = b ^ 1u;
+    s_tx_len[b ^ 1u]   = 0u;
+    s_tx_busy          = true;
+    s_tx_inflight      = len;
+    s_stats.tx_packets++;
+    usb_hw_ep_write(USB_CDC_EP_DATA_IN, (const uint8_t *)s_tx_buf[b], len);
+}
+
+static void rx_arm(uint8_t b)
+{
+    s_rx_armed = b;
+    usb_hw_ep_read_arm(USB_CDC_EP_DATA_OUT, (uint8_t *)s_rx_buf[b], USB_CDC_PACKET);
+}
+
+static void data_reset(void)
+{
+    s_tx_len[0] = s_tx_len[1] = 0u;
+    s_tx_fill     = 0u;
+    s_tx_busy     = false;
+    s_tx_stalled  = false;
+    s_tx_inflight = 0u;
+
+    s_rx_len[0] = s_rx_len[1] = 0u;
+    s_rx_armed = RX_NONE;
+    s_rx_read  = 0u;
+    s_rx_pos   = 0u;
+}
+
+static void cdc_open(void)
+{
+    data_reset();
+    usb_hw_ep_open(USB_CDC_EP_DATA_IN,  USB_EP_TYPE_BULK, USB_CDC_PACKET);
+    usb_hw_ep_open(USB_CDC_EP_DATA_OUT, USB_EP_TYPE_BULK, USB_CDC_PACKET);
+    usb_hw_ep_open(USB_CDC_EP_NOTIFY,   USB_EP_TYPE_INTR, NOTIFY_PACKET);
+    rx_arm(0u);
+    s_configured = true;
+}
+
+static void cdc_close(void)
+{
+    s_configured = false;
+    s_dtr        = false;
+    data_reset();
+}
+
+/* ------------------------------------------------------------------ */
+/*  Endpoint 0                                                        */
+/* ------------------------------------------------------------------ */
+
+static void ep0_in_next(void)
+{
+    uint16_t n = (s_ep0.remaining > EP0_SIZE) ? EP0_SIZE : s_ep0.remaining;
+
+    usb_hw_ep_write(USB_EP_IN | 0u, s_ep0.data, n);
+    s_ep0.data      += n;
+    s_ep0.remaining -= n;
+
+    if (n < EP0_SIZE) s_ep0.zlp = false;    /* a short packet ends the stage */
+    s_ep0.in_active = (s_ep0.remaining != 0u) || s_ep0.zlp;
+}
+
+static bool ep0_reply(const uint8_t *data, uint16_t len, uint16_t w_length)
+{
+    if (len > w_length) len = w_length;
+
+    s_ep0.data      = data;
+    s_ep0.remaining = len;
+    s_ep0.zlp       = (len < w_length) && (len % EP0_SIZE == 0u);
+    ep0_in_next();
+    return true;
+}
+
+static bool ep0_status(void)
+{
+    usb_hw_ep_write(USB_EP_IN | 0u, NULL, 0u);
+    return true;
+}
+
+static uint16_t string_desc(uint8_t index, uint8_t *out)
+{
+    if (index == 0u)
+    {
+        out[0] = 4u; out[1] = DESC_STRING;
+        out[2] = 0x09u; out[3] = 0x04u;     /* en-US */
+        return 4u;
+    }
+
+    char        serial[9];
+    const char *s = NULL;
+
+    if (index == 3u)
+    {
+        static const char hex[] = "0123456789ABCDEF";
+        uint32_t id = usb_hw_device_id();
+        for (uint8_t i = 0u; i < 8u; i++) serial[i] = hex[(id >> (28u - 4u * i)) & 0xFu];
+        serial[8] = '\0';
+        s = serial;
+    }
+    else if (index < sizeof(s_strings) / sizeof(s_strings[0]))
+    {
+        s = s_strings[index];
+    }
+    if (s == NULL) return 0u;
+
+    uint8_t n = 0u;
+    while (s[n] != '\0' && n < STRING_MAX_CHARS)
+    {
+        out[2u + 2u * n] = (uint8_t)s[n];
+        out[3u + 2u * n] = 0u;
+        n++;
+    }
+    out[0] = (uint8_t)(2u + 2u * n);
+    out[1] = DESC_STRING;
+    return out[0];
+}
+
+static bool is_data_endpoint(uint8_t ep_addr)
+{
+    return s_configured && (ep_addr == USB_CDC_EP_DATA_IN || ep_addr == USB_CDC_EP_DATA_OUT ||
+                            ep_addr == USB_CDC_EP_NOTIFY);
+}
+
+/* ENDPOINT_HALT on the CDC endpoints; device features are accepted and ignored */
+static bool feature_request(uint8_t type, uint16_t value, uint16_t index, bool set)
+{
+    uint8_t ep_addr = (uint8_t)index;
+
+    if ((type & REQ_RECIP_MASK) != REQ_RECIP_ENDPOINT) return ep0_status();
+    if (value != FEATURE_ENDPOINT_HALT)                return false;
+    if (USB_EP_NUM(ep_addr) == 0u)                     return ep0_status();
+    if (!is_data_endpoint(ep_addr))                    return false;
+
+    if (set) usb_hw_ep_stall(ep_addr);
+    else     usb_hw_ep_clear_stall(ep_addr);
+    return ep0_status();
+}
+
+static bool std_request(uint8_t type, uint8_t request, uint16_t value, uint16_t index, uint16_t length)
+{
+    switch (request)
+    {
+        case REQ_GET_STATUS:
+            s_ep0_reply[0] = 0u;
+            s_ep0_reply[1] = 0u;
+            return ep0_reply(s_ep0_reply, 2u, length);
+
+        case REQ_CLEAR_FEATURE:
+            return feature_request(type, value, index, false);
+
+        case REQ_SET_FEATURE:
+            return feature_request(type, value, index, true);
+
+        case REQ_SET_ADDRESS:
+            /* the OTG core wants the address before the status stage */
+            usb_hw_set_address((uint8_t)(value & 0x7Fu));
+            return ep0_status();
+
+        case REQ_GET_DESCRIPTOR:
+            switch (value >> 8)
+            {
+                case DESC_DEVICE: return ep0_reply(s_device_desc, sizeof(s_device_desc), length);
+                case DESC_CONFIG: return ep0_reply(s_config_desc, sizeof(s_config_desc), length);
+                case DESC_STRING:
+                {
+                    uint16_t n = string_desc((uint8_t)value, s_ep0_reply);
+                    return (n != 0u) && ep0_reply(s_ep0_reply, n, length);
+                }
+                default:          return false;
+            }
+
+        case REQ_GET_CONFIGURATION:
+            s_ep0_reply[0] = s_config_value;
+            return ep0_reply(s_ep0_reply, 1u, length);
+
+        case REQ_SET_CONFIGURATION:
+            if (value > 1u) return false;
+            s_config_value = (uint8_t)value;
+            if (value == 1u) cdc_open();
+            else             cdc_close();
+            return ep0_status();
+
+        case REQ_GET_INTERFACE:
+            s_ep0_reply[0] = 0u;
+            return ep0_reply(s_ep0_reply, 1u, length);
+
+        case REQ_SET_INTERFACE:
+            return (value == 0u) && ep0_status();
+
+        default:
+            return false;
+    }
+}
+
+static bool cdc_request(uint8_t request, uint16_t value, uint16_t length)
+{
+    switch (request)
+    {
+        case CDC_SET_LINE_CODING:
+            if (length != CDC_LINE_CODING_SIZE) return false;
+            s_ep0.out_pending = true;       /* status after the data stage */
+            return true;
+
+        case CDC_GET_LINE_CODING:
+            memcpy(s_ep0_reply, &s_line.baud, 4u);     /* little-endian on both ends */
+            s_ep0_reply[4] = s_line.stop_bits;
+            s_ep0_reply[5] = s_line.parity;
+            s_ep0_reply[6] = s_line.data_bits;
+            return ep0_reply(s_ep0_reply, CDC_LINE_CODING_SIZE, length);
+
+        case CDC_SET_CONTROL_LINE_STATE:
+            s_dtr = (value & CDC_CONTROL_DTR) != 0u;
+            return ep0_status();
+
+        case CDC_SEND_BREAK:
+            return ep0_status();
+
+        default:
+            return false;
+    }
+}
+
+/* ================================================================== */
+/*  Controller events                                                 */
+/* ================================================================== */
+
+void usb_dev_on_reset(void)
+{
+    s_stats.resets++;
+    s_config_value = 0u;
+    s_suspended    = false;
+    s_ep0          = (ep0_state_t){0};
+    cdc_close();
+    usb_hw_ep_read_arm(0x00u, (uint8_t *)s_ep0_out, EP0_SIZE);
+}
+
+void usb_dev_on_suspend(bool suspended)
+{
+    s_suspended = suspended;
+}
+
+void usb_dev_on_setup(const uint8_t setup[8])
+{
+    uint8_t  type    = setup[0];
+    uint8_t  request = setup[1];
+    uint16_t value   = (uint16_t)(setup[2] | (setup[3] << 8));
+    uint16_t index   = (uint16_t)(setup[4] | (setup[5] << 8));
+    uint16_t length  = (uint16_t)(setup[6] | (setup[7] << 8));
+
+    s_ep0.in_active   = false;
+    s_ep0.out_pending = false;
+
+    /* keeps EP0 OUT ready for a data stage, the status stage or the next SETUP */
+    usb_hw_ep_read_arm(0x00u, (uint8_t *)s_ep0_out, EP0_SIZE);
+
+    bool ok;
+    switch (type & REQ_TYPE_MASK)
+    {
+        case REQ_TYPE_STANDARD: ok = std_request(type, request, value, index, length); break;
+        case REQ_TYPE_CLASS:    ok = cdc_request(request, value, length);               break;
+        default:                ok = false;                                             break;
+    }
+
+    if (!ok)
+    {
+        usb_hw_ep_stall(USB_EP_IN | 0u);
+        usb_hw_ep_stall(0x00u);
+    }
+}
+
+void usb_dev_on_out(uint8_t ep_num, uint16_t len)
+{
+    if (ep_num == 0u)
+    {
+        if (s_ep0.out_pending && len >= CDC_LINE_CODING_SIZE)
+        {
+            const uint8_t *d = (const uint8_t *)s_ep0_out;
+            memcpy(&s_line.baud, d, 4u);
+            s_line.stop_bits  = d[4];
+            s_line.parity     = d[5];
+            s_line.data_bits  = d[6];
+            s_ep0.out_pending = false;
+            (void)ep0_status();
+        }
+        usb_hw_ep_read_arm(0x00u, (uint8_t *)s_ep0_out, EP0_SIZE);
+        return;
+    }
+
+    if (ep_num != USB_EP_NUM(USB_CDC_EP_DATA_OUT)) return;
+
+    uint8_t b = s_rx_armed;
+    if (b == RX_NONE) return;
+    if (len == 0u)
+    {
+        rx_arm(b);
+        return;
+    }
+
+    s_rx_len[b] = len;
+    s_stats.rx_bytes += len;
+    s_stats.rx_packets++;
+
+    if (s_rx_len[b ^ 1u] == 0u)
+    {
+        rx_arm(b ^ 1u);
+    }
+    else
+    {
+        s_rx_armed = RX_NONE;               /* host is NAKed until a buffer drains */
+        s_stats.rx_naks++;
+    }
+}
+
+void usb_dev_on_in_done(uint8_t ep_num)
+{
+    if (ep_num == 0u)
+    {
+        if (s_ep0.in_active) ep0_in_next();
+        return;
+    }
+
+    if (ep_num == USB_EP_NUM(USB_CDC_EP_DATA_IN))
+    {
+        s_tx_busy    = false;
+        s_tx_stalled = false;               /* the host is reading again */
+        if (s_configured) tx_kick();
+    }
+}
+
+/* ================================================================== */
+/*  Comm instance                                                     */
+/* ================================================================== */
+
+void usb_cdc_protocol_init(void)
+{
+    s_usb_is_init = 1u;
+    s_usb_ok      = usb_hw_init();
+}
+
+/*
+ * Appends to the IN packet being filled. An idle endpoint is kicked when
+ * the packet is full, or at the end when flush is set. *waited_from
+ * carries the stall timer across segments. Returns false when the rest
+ * was dropped (no host or timeout). After a timeout every send drops at
+ * once until the host takes a packet, so a paused terminal costs one
+ * USB_CDC_TX_TIMEOUT_US and not one per call.
+ */
+static bool tx_append(const uint8_t *data, uint32_t len, uint32_t *waited_from, bool flush)
+{
+    while (len != 0u)
+    {
+        if (!host_ready() || s_tx_stalled)
+        {
+            s_stats.tx_dropped += len;
+            return false;
+        }
+
+        uint32_t primask = irq_save();
+        uint8_t  b       = s_tx_fill;
+        uint32_t room    = USB_CDC_PACKET - s_tx_len[b];
+        uint32_t n       = (len < room) ? len : room;
+
+        memcpy((uint8_t *)s_tx_buf[b] + s_tx_len[b], data, n);
+        s_tx_len[b]      = (uint16_t)(s_tx_len[b] + n);
+        s_stats.tx_bytes += n;
+        if (!s_tx_busy && (s_tx_len[b] == USB_CDC_PACKET || (flush && n == len))) tx_kick();
+        irq_restore(primask);
+
+        data += n;
+        len  -= n;
+
+        if (n != 0u)
+        {
+            *waited_from = timebase_us_get32();
+        }
+        else if ((timebase_us_get32() - *waited_from) > USB_CDC_TX_TIMEOUT_US)
+        {
+            s_stats.tx_dropped += len;      /* host stopped reading */
+            s_tx_stalled = true;
+            return false;
+        }
+        else
+        {
+            usb_hw_poll();
+        }
+    }
+    return true;
+}
+
+void usb_cdc_protocol_send(uint8_t *data, uint32_t len)
+{
+    INTERFACE_LAZY_INIT(s_usb_is_init, usb_cdc_protocol_init);
+    if (data == NULL) return;
+
+    uint32_t waited_from = timebase_us_get32();
+    (void)tx_append(data, len, &waited_from, true);
+}
+
+/* Segments go straight into the IN packet buffers, so a header and its payload share a packet */
+void usb_cdc_protocol_sendv(const comm_iovec_t *iov, uint8_t count)
+{
+    INTERFACE_LAZY_INIT(s_usb_is_init, usb_cdc_protocol_init);
+
+    uint32_t waited_from = timebase_us_get32();
+
+    for (uint8_t i = 0u; i < count; i++)
+    {
+        if (iov[i].base == NULL) continue;
+        if (!tx_append(iov[i].base, iov[i].len, &waited_from, false))
+        {
+            for (uint8_t j = i + 1u; j < count; j++) s_stats.tx_dropped += iov[j].len;
+            break;
+        }
+    }
+
+    uint32_t primask = irq_save();
+    if (!s_tx_busy) tx_kick();
+    irq_restore(primask);
+}
+
+uint8_t usb_cdc_protocol_receive(uint8_t *buffer, uint32_t len)
+{
+    INTERFACE_LAZY_INIT(s_usb_is_init, usb_cdc_protocol_init);
+    if (buffer == NULL || len == 0u) return 0u;
+    if (len > 255u) len = 255u;
+
+    uint32_t got     = 0u;
+    uint32_t primask = irq_save();
+
+    while (got < len)
+    {
+        uint8_t  b     = s_rx_read;
+        uint16_t avail = s_rx_len[b];
+        if (avail == 0u) break;
+
+        uint32_t n = avail - s_rx_pos;
+        if (n > len - got) n = len - got;
+
+        memcpy(buffer + got, (const uint8_t *)s_rx_buf[b] + s_rx_pos, n);
+        got      += n;
+        s_rx_pos  = (uint16_t)(s_rx_pos + n);
+
+        if (s_rx_pos == avail)
+        {
+            s_rx_len[b] = 0u;
+            s_rx_pos    = 0u;
+            s_rx_read   = b ^ 1u;
+            if (s_rx_armed == RX_NONE && s_configured) rx_arm(b);
+        }
+    }
+
+    irq_restore(primask);
+    return (uint8_t)got;
+}
+
+uint8_t usb_cdc_protocol_data_available(void)
+{
+    INTERFACE_LAZY_INIT(s_usb_is_init, usb_cdc_protocol_init);
+    return s_rx_len[s_rx_read] != 0u;
+}
+
+/* ================================================================== */
+/*  Status                                                            */
+/* ================================================================== */
+
+bool usb_cdc_init_ok(void)
+{
+    return s_usb_ok;
+}
+
+bool usb_cdc_configured(void)
+{
+    return s_configured;
+}
+
+bool usb_cdc_dtr(void)
+{
+    return s_dtr;
+}
+
+void usb_cdc_line_coding(usb_cdc_line_coding_t *out)
+{
+    if (out == NULL) return;
+    *out = s_line;
+}
+
+void usb_cdc_stats(usb_cdc_stats_t *out)
+{
+    if (out == NULL) return;
+
+    uint32_t primask = irq_save();
+    *out = s_stats;
+    irq_restore(primask);
+}
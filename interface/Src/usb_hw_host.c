@@ -0,0 +1,223 @@
+/**
+ * @file usb_hw_host.c
+ * @brief Host backend for usb_hw.h — endpoint FIFO model
+ *
+ * Built into interface_host (BUILD_TESTS) with INTERFACE_HOST defined.
+ * The test plays the USB host through the usb_sim_* calls in
+ * interface_usb.h; events reach the device core synchronously, as the
+ * OTG interrupt would deliver them.
+ *
+ * Bus time: a full-speed packet costs its payload plus ~13 bytes of
+ * token, handshake, CRC and inter-packet gap at 12 Mbit/s. Each packet
+ * moved advances the virtual timebase by that amount.
+ */
+
+#include "interface_usb.h"
+#include "usb_hw.h"
+#include "interface_timebase_us.h"
+
+#include <string.h>
+
+#define SIM_EPS             4u
+#define SIM_MAX_PACKET      64u
+#define SIM_PACKET_OVERHEAD 13u
+#define SIM_BIT_NS          83u         /* 1 / 12 MHz, rounded */
+
+typedef struct
+{
+    uint8_t  data[SIM_MAX_PACKET];
+    uint16_t len;
+} sim_packet_t;
+
+typedef struct
+{
+    sim_packet_t   in[USB_SIM_IN_DEPTH];
+    uint8_t        in_head;
+    uint8_t        in_count;
+    bool           in_stalled;
+    bool           out_stalled;
+    uint8_t       *out_buf;             /* armed by the device, NULL = NAK */
+    uint16_t       out_cap;
+    uint16_t       max_packet;
+    usb_sim_sink_t sink;
+} sim_ep_t;
+
+static sim_ep_t s_eps[SIM_EPS];
+static uint8_t  s_address = 0u;
+static uint64_t s_bus_ns = 0u;
+
+static void bus_time(uint16_t payload)
+{
+    s_bus_ns += (uint64_t)(payload + SIM_PACKET_OVERHEAD) * 8u * SIM_BIT_NS;
+    timebase_us_host_advance(s_bus_ns / 1000u);
+    s_bus_ns %= 1000u;
+}
+
+/* Drops endpoint state as a bus reset does; sinks belong to the host side */
+static void sim_bus_reset(void)
+{
+    for (uint8_t n = 0u; n < SIM_EPS; n++)
+    {
+        usb_sim_sink_t sink = s_eps[n].sink;
+        memset(&s_eps[n], 0, sizeof(s_eps[n]));
+        s_eps[n].sink = sink;
+    }
+    s_eps[0].max_packet = SIM_MAX_PACKET;
+    s_address = 0u;
+}
+
+/* ================================================================== */
+/*  usb_hw.h                                                          */
+/* ================================================================== */
+
+bool usb_hw_init(void)
+{
+    sim_bus_reset();
+    return true;
+}
+
+void usb_hw_set_address(uint8_t address)
+{
+    s_address = address;
+}
+
+void usb_hw_ep_open(uint8_t ep_addr, uint8_t type, uint16_t max_packet)
+{
+    (void)type;
+    sim_ep_t *ep = &s_eps[USB_EP_NUM(ep_addr) % SIM_EPS];
+    ep->max_packet = max_packet;
+    if (ep_addr & USB_EP_IN) { ep->in_count = 0u; ep->in_stalled = false; }
+    else                     { ep->out_buf = NULL; ep->out_stalled = false; }
+}
+
+void usb_hw_ep_stall(uint8_t ep_addr)
+{
+    sim_ep_t *ep = &s_eps[USB_EP_NUM(ep_addr) % SIM_EPS];
+    if (ep_addr & USB_EP_IN) ep->in_stalled = true;
+    else                     ep->out_stalled = true;
+}
+
+/* The model does not track data toggles */
+void usb_hw_ep_clear_stall(uint8_t ep_addr)
+{
+    sim_ep_t *ep = &s_eps[USB_EP_NUM(ep_addr) % SIM_EPS];
+    if (ep_addr & USB_EP_IN) ep->in_stalled = false;
+    else                     ep->out_stalled = false;
+}
+
+void usb_hw_ep_write(uint8_t ep_addr, const uint8_t *data, uint16_t len)
+{
+    sim_ep_t *ep = &s_eps[USB_EP_NUM(ep_addr) % SIM_EPS];
+
+    if (ep->in_count == USB_SIM_IN_DEPTH || len > SIM_MAX_PACKET) return;   /* device bug */
+
+    sim_packet_t *p = &ep->in[(ep->in_head + ep->in_count) % USB_SIM_IN_DEPTH];
+    if (len != 0u) memcpy(p->data, data, len);
+    p->len = len;
+    ep->in_count++;
+}
+
+void usb_hw_ep_read_arm(uint8_t ep_addr, uint8_t *buf, uint16_t len)
+{
+    sim_ep_t *ep = &s_eps[USB_EP_NUM(ep_addr) % SIM_EPS];
+    ep->out_buf = buf;
+    ep->out_cap = len;
+}
+
+uint32_t usb_hw_device_id(void)
+{
+    return 0x0F411CDCu;
+}
+
+void usb_hw_poll(void)
+{
+    bool moved = false;
+
+    for (uint8_t n = 1u; n < SIM_EPS; n++)
+    {
+        sim_ep_t *ep = &s_eps[n];
+        if (ep->sink == NULL) continue;
+
+        uint8_t buf[SIM_MAX_PACKET];
+        int len;
+        while ((len = usb_sim_in(n, buf, sizeof(buf))) >= 0)
+        {
+            ep->sink(buf, (uint16_t)len);
+            moved = true;
+        }
+    }
+
+    /* an idle bus still lets time pass, or a waiting sender never times out */
+    if (!moved) timebase_us_host_advance(1u);
+}
+
+/* ================================================================== */
+/*  Host side                                                         */
+/* ================================================================== */
+
+void usb_sim_attach(void)
+{
+    sim_bus_reset();
+    usb_dev_on_reset();
+}
+
+int usb_sim_setup(const uint8_t setup[8])
+{
+    /* a SETUP clears an EP0 stall and flushes any stale EP0 IN data */
+    s_eps[0].in_stalled  = false;
+    s_eps[0].out_stalled = false;
+    s_eps[0].in_count    = 0u;
+
+    bus_time(8u);
+    usb_dev_on_setup(setup);
+    return s_eps[0].in_stalled ? USB_SIM_STALL : 0;
+}
+
+int usb_sim_out(uint8_t ep_num, const uint8_t *data, uint16_t len)
+{
+    sim_ep_t *ep = &s_eps[ep_num % SIM_EPS];
+
+    if (ep->out_stalled)                        return USB_SIM_STALL;
+    if (ep->out_buf == NULL || len > ep->out_cap) return USB_SIM_NAK;
+
+    uint8_t *dst = ep->out_buf;
+    ep->out_buf = NULL;                         /* one packet per arm */
+    if (len != 0u) memcpy(dst, data, len);
+
+    bus_time(len);
+    usb_dev_on_out(ep_num, len);
+    return len;
+}
+
+int usb_sim_in(uint8_t ep_num, uint8_t *buf, uint16_t cap)
+{
+    sim_ep_t *ep = &s_eps[ep_num % SIM_EPS];
+
+    if (ep->in_stalled)     return USB_SIM_STALL;
+    if (ep->in_count == 0u) return USB_SIM_NAK;
+
+    sim_packet_t *p = &ep->in[ep->in_head];
+    uint16_t len = (p->len < cap) ? p->len : cap;
+    memcpy(buf, p->data, len);
+    ep->in_head = (uint8_t)((ep->in_head + 1u) % USB_SIM_IN_DEPTH);
+    ep->in_count--;
+
+    bus_time(p->len);
+    usb_dev_on_in_done(ep_num);
+    return len;
+}
+
+uint8_t usb_sim_address(void)
+{
+    return s_address;
+}
+
+void usb_sim_suspend(bool suspended)
+{
+    usb_dev_on_suspend(suspended);
+}
+
+void usb_sim_set_in_sink(uint8_t ep_num, usb_sim_sink_t sink)
+{
+    s_eps[ep_num % SIM_EPS].sink = sink;
+}
@@ -0,0 +1,458 @@
+#include "usb_hw.h"
+#include "interface_irq.h"
+#include "interface_cycles.h"
+#include "interface_defines.h"
+#include "driver_gpio.h"
+#include "driver_interrupt.h"
+
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/*  Registers                                                         */
+/* ------------------------------------------------------------------ */
+
+#define OTG_BASE                0x50000000UL
+#define OTG_REG(off)            (*(volatile uint32_t *)(OTG_BASE + (off)))
+
+#define OTG_GAHBCFG             OTG_REG(0x008u)
+#define OTG_GUSBCFG             OTG_REG(0x00Cu)
+#define OTG_GRSTCTL             OTG_REG(0x010u)
+#define OTG_GINTSTS             OTG_REG(0x014u)
+#define OTG_GINTMSK             OTG_REG(0x018u)
+#define OTG_GRXSTSP             OTG_REG(0x020u)
+#define OTG_GRXFSIZ             OTG_REG(0x024u)
+#define OTG_DIEPTXF0            OTG_REG(0x028u)
+#define OTG_GCCFG               OTG_REG(0x038u)
+#define OTG_DIEPTXF(n)          OTG_REG(0x104u + 4u * ((n) - 1u))
+#define OTG_DCFG                OTG_REG(0x800u)
+#define OTG_DCTL                OTG_REG(0x804u)
+#define OTG_DIEPMSK             OTG_REG(0x810u)
+#define OTG_DOEPMSK             OTG_REG(0x814u)
+#define OTG_DAINT               OTG_REG(0x818u)
+#define OTG_DAINTMSK            OTG_REG(0x81Cu)
+#define OTG_DIEPCTL(n)          OTG_REG(0x900u + 0x20u * (n))
+#define OTG_DIEPINT(n)          OTG_REG(0x908u + 0x20u * (n))
+#define OTG_DIEPTSIZ(n)         OTG_REG(0x910u + 0x20u * (n))
+#define OTG_DOEPCTL(n)          OTG_REG(0xB00u + 0x20u * (n))
+#define OTG_DOEPINT(n)          OTG_REG(0xB08u + 0x20u * (n))
+#define OTG_DOEPTSIZ(n)         OTG_REG(0xB10u + 0x20u * (n))
+#define OTG_PCGCCTL             OTG_REG(0xE00u)
+#define OTG_FIFO(n)             OTG_REG(0x1000u * ((n) + 1u))
+
+#define GAHBCFG_GINTMSK         (1u << 0)
+#define GUSBCFG_PHYSEL          (1u << 6)
+#define GUSBCFG_TRDT_POS        10u
+#define GUSBCFG_TRDT_MASK       (0xFu << GUSBCFG_TRDT_POS)
+#define GUSBCFG_FDMOD           (1u << 30)
+#define GRSTCTL_CSRST           (1u << 0)
+#define GRSTCTL_RXFFLSH         (1u << 4)
+#define GRSTCTL_TXFFLSH         (1u << 5)
+#define GRSTCTL_TXFNUM_ALL      (0x10u << 6)
+#define GRSTCTL_AHBIDL          (1u << 31)
+#define GINT_RXFLVL             (1u << 4)
+#define GINT_USBSUSP            (1u << 11)
+#define GINT_USBRST             (1u << 12)
+#define GINT_ENUMDNE            (1u << 13)
+#define GINT_IEPINT             (1u << 18)
+#define GINT_OEPINT             (1u << 19)
+#define GINT_WKUPINT            (1u << 31)
+#define GCCFG_PWRDWN            (1u << 16)
+#define GCCFG_NOVBUSSENS        (1u << 21)
+#define DCFG_DSPD_FS            (3u << 0)
+#define DCFG_DAD_POS            4u
+#define DCFG_DAD_MASK           (0x7Fu << DCFG_DAD_POS)
+#define DCTL_SDIS               (1u << 1)
+#define DCTL_CGINAK             (1u << 8)
+#define EPCTL_USBAEP            (1u << 15)
+#define EPCTL_EPTYP_POS         18u
+#define EPCTL_STALL             (1u << 21)
+#define EPCTL_TXFNUM_POS        22u
+#define EPCTL_CNAK              (1u << 26)
+#define EPCTL_SNAK              (1u << 27)
+#define EPCTL_SD0PID            (1u << 28)
+#define EPCTL_EPENA             (1u << 31)
+#define EPINT_XFRC              (1u << 0)
+#define EPINT_STUP              (1u << 3)
+#define TSIZ_PKTCNT_1           (1u << 19)
+#define DOEPTSIZ0_STUPCNT_3     (3u << 29)
+#define GRXSTS_EPNUM(s)         ((s) & 0xFu)
+#define GRXSTS_BCNT(s)          (((s) >> 4) & 0x7FFu)
+#define GRXSTS_PKTSTS(s)        (((s) >> 17) & 0xFu)
+#define PKTSTS_OUT_DATA         2u
+#define PKTSTS_SETUP_DATA       6u
+
+/* 48 MHz for the USB core: 25 MHz HSE / M 25 * N 192 / Q 4. SYSCLK stays on HSI. */
+#define RCC_CR_REG              (*(volatile uint32_t *)0x40023800UL)
+#define RCC_PLLCFGR_REG         (*(volatile uint32_t *)0x40023804UL)
+#define RCC_CR_HSEON            (1u << 16)
+#define RCC_CR_HSERDY           (1u << 17)
+#define RCC_CR_PLLON            (1u << 24)
+#define RCC_CR_PLLRDY           (1u << 25)
+#define RCC_PLLCFGR_USB48       ((25u << 0) | (192u << 6) | (0u << 16) | (1u << 22) | (4u << 24))
+#define RCC_AHB2ENR_OTGFSEN     (1u << 7)
+
+/* HSE start-up is ~2 ms on the Black Pill crystal, PLL lock ~100 us, core reset a few clocks */
+#define USB_HSE_TIMEOUT_US      100000u
+#define USB_PLL_TIMEOUT_US      10000u
+#define USB_CORE_TIMEOUT_US     1000u
+
+#define UID_BASE                ((volatile const uint32_t *)0x1FFF7A10UL)
+
+#define USB_PA11_ALTFN_OTG_FS   GPIO_PIN_ALTFN_10
+
+/*
+ * FIFO RAM is 320 words. RX is shared by all OUT endpoints and must hold
+ * a SETUP burst plus two bulk packets; the data IN FIFO holds two packets
+ * so the next one can load while the host reads the current one.
+ */
+#define FIFO_RX_WORDS           128u
+#define FIFO_EP0_WORDS          16u
+#define FIFO_DATA_WORDS         32u
+#define FIFO_NOTIFY_WORDS       16u
+
+#define OTG_EPS                 4u
+
+static uint8_t  *s_out_buf[OTG_EPS];
+static uint16_t  s_out_len[OTG_EPS];
+static uint32_t  s_setup[2];
+
+/* ------------------------------------------------------------------ */
+/*  Private helpers                                                   */
+/* ------------------------------------------------------------------ */
+
+/* Spin until (*reg & mask) == want; false once timeout_us has passed */
+static bool wait_bits(volatile uint32_t *reg, uint32_t mask, uint32_t want, uint32_t timeout_us)
+{
+    uint32_t t0    = cycles_now();
+    uint32_t limit = timeout_us * (cycles_core_hz() / 1000000u);
+
+    while ((*reg & mask) != want)
+    {
+        if (cycles_now() - t0 > limit) return false;
+    }
+    return true;
+}
+
+/* false if the crystal or the PLL never came up (board without HSE) */
+static bool usb_clock_init(void)
+{
+    if (!(RCC_CR_REG & RCC_CR_PLLRDY))
+    {
+        RCC_CR_REG |= RCC_CR_HSEON;
+        if (!wait_bits(&RCC_CR_REG, RCC_CR_HSERDY, RCC_CR_HSERDY, USB_HSE_TIMEOUT_US))
+        {
+            RCC_CR_REG &= ~RCC_CR_HSEON;
+            return false;
+        }
+
+        RCC_PLLCFGR_REG = RCC_PLLCFGR_USB48;
+        RCC_CR_REG     |= RCC_CR_PLLON;
+        if (!wait_bits(&RCC_CR_REG, RCC_CR_PLLRDY, RCC_CR_PLLRDY, USB_PLL_TIMEOUT_US)) return false;
+    }
+
+    RCC->AHB2ENR |= RCC_AHB2ENR_OTGFSEN;
+    return true;
+}
+
+static void usb_pins_init(void)
+{
+    GPIO_PinConfig_t pin = {
+        .pGPIOx              = GPIOA,
+        .GPIO_PinNumber      = GPIO_PIN_NO_11,
+        .GPIO_PinMode        = GPIO_MODE_ALTFN,
+        .GPIO_PinSpeed       = GPIO_SPEED_HIGH,
+        .GPIO_PinOPType      = GPIO_OP_TYPE_PP,
+        .GPIO_PinPuPdControl = GPIO_NO_PUPD,
+        .GPIO_PinAltFunMode  = USB_PA11_ALTFN_OTG_FS,
+    };
+    GPIO_Init(&pin);
+
+    pin.GPIO_PinNumber = GPIO_PIN_NO_12;
+    GPIO_Init(&pin);
+}
+
+/* Turnaround time in PHY clocks, from the AHB frequency (RM0383 table) */
+static uint32_t usb_trdt(uint32_t hclk)
+{
+    if (hclk >= 32000000u) return 0x6u;
+    if (hclk >= 27500000u) return 0x7u;
+    if (hclk >= 24000000u) return 0x8u;
+    if (hclk >= 21800000u) return 0x9u;
+    if (hclk >= 20000000u) return 0xAu;
+    if (hclk >= 18500000u) return 0xBu;
+    if (hclk >= 17200000u) return 0xCu;
+    if (hclk >= 16000000u) return 0xDu;
+    if (hclk >= 15000000u) return 0xEu;
+    return 0xFu;
+}
+
+static void usb_flush_fifos(void)
+{
+    OTG_GRSTCTL = GRSTCTL_TXFFLSH | GRSTCTL_TXFNUM_ALL;
+    while (OTG_GRSTCTL & GRSTCTL_TXFFLSH) {}
+    OTG_GRSTCTL = GRSTCTL_RXFFLSH;
+    while (OTG_GRSTCTL & GRSTCTL_RXFFLSH) {}
+}
+
+/* Word accesses only: the FIFO window ignores byte lanes */
+static void fifo_read(uint8_t *dst, uint16_t len)
+{
+    uint32_t *w = (uint32_t *)dst;          /* aligned and word-rounded, see usb_hw.h */
+    for (uint16_t i = 0u; i < len; i += 4u)
+    {
+        *w++ = OTG_FIFO(0u);
+    }
+}
+
+static void fifo_discard(uint16_t len)
+{
+    for (uint16_t i = 0u; i < len; i += 4u)
+    {
+        (void)OTG_FIFO(0u);
+    }
+}
+
+static void usb_on_bus_reset(void)
+{
+    for (uint8_t n = 0u; n < OTG_EPS; n++)
+    {
+        OTG_DIEPINT(n) = 0xFFu;
+        OTG_DOEPINT(n) = 0xFFu;
+        OTG_DOEPCTL(n) |= EPCTL_SNAK;
+        s_out_buf[n] = NULL;
+        s_out_len[n] = 0u;
+    }
+
+    OTG_DAINTMSK = (1u << 16) | (1u << 0);
+    OTG_DCFG    &= ~DCFG_DAD_MASK;
+    usb_flush_fifos();
+    usb_dev_on_reset();
+}
+
+static void usb_on_rx_level(void)
+{
+    uint32_t sts = OTG_GRXSTSP;
+    uint8_t  n   = (uint8_t)GRXSTS_EPNUM(sts);
+    uint16_t len = (uint16_t)GRXSTS_BCNT(sts);
+
+    switch (GRXSTS_PKTSTS(sts))
+    {
+        case PKTSTS_SETUP_DATA:
+            s_setup[0] = OTG_FIFO(0u);
+            s_setup[1] = OTG_FIFO(0u);
+            break;
+
+        case PKTSTS_OUT_DATA:
+            if (n < OTG_EPS && s_out_buf[n] != NULL && len != 0u)
+            {
+                fifo_read(s_out_buf[n] + s_out_len[n], len);
+                s_out_len[n] = (uint16_t)(s_out_len[n] + len);
+            }
+            else
+            {
+                fifo_discard(len);
+            }
+            break;
+
+        default:                            /* completion markers carry no data */
+            break;
+    }
+}
+
+static void usb_on_out_ep(void)
+{
+    uint32_t daint = (OTG_DAINT & OTG_DAINTMSK) >> 16;
+
+    for (uint8_t n = 0u; n < OTG_EPS; n++)
+    {
+        if (!(daint & (1u << n))) continue;
+
+        uint32_t st = OTG_DOEPINT(n) & OTG_DOEPMSK;
+        OTG_DOEPINT(n) = st;
+
+        if (st & EPINT_XFRC)
+        {
+            uint16_t len = s_out_len[n];
+            s_out_buf[n] = NULL;
+            s_out_len[n] = 0u;
+            usb_dev_on_out(n, len);
+        }
+        if (st & EPINT_STUP)
+        {
+            usb_dev_on_setup((const uint8_t *)s_setup);
+        }
+    }
+}
+
+static void usb_on_in_ep(void)
+{
+    uint32_t daint = OTG_DAINT & OTG_DAINTMSK & 0xFFFFu;
+
+    for (uint8_t n = 0u; n < OTG_EPS; n++)
+    {
+        if (!(daint & (1u << n))) continue;
+
+        uint32_t st = OTG_DIEPINT(n) & OTG_DIEPMSK;
+        OTG_DIEPINT(n) = st;
+
+        if (st & EPINT_XFRC) usb_dev_on_in_done(n);
+    }
+}
+
+/* ================================================================== */
+/*  usb_hw.h                                                          */
+/* ================================================================== */
+
+bool usb_hw_init(void)
+{
+    if (!usb_clock_init()) return false;
+    usb_pins_init();
+
+    if (!wait_bits(&OTG_GRSTCTL, GRSTCTL_AHBIDL, GRSTCTL_AHBIDL, USB_CORE_TIMEOUT_US)) return false;
+    OTG_GRSTCTL |= GRSTCTL_CSRST;
+    if (!wait_bits(&OTG_GRSTCTL, GRSTCTL_CSRST, 0u, USB_CORE_TIMEOUT_US)) return false;
+
+    OTG_GUSBCFG = GUSBCFG_FDMOD | GUSBCFG_PHYSEL
+                | (usb_trdt(cycles_core_hz()) << GUSBCFG_TRDT_POS);
+    OTG_GCCFG   = GCCFG_PWRDWN | GCCFG_NOVBUSSENS;     /* VBUS is not wired on the Black Pill */
+    OTG_PCGCCTL = 0u;
+    OTG_DCFG    = DCFG_DSPD_FS;
+    OTG_DCTL   |= DCTL_SDIS;
+
+    OTG_GRXFSIZ  = FIFO_RX_WORDS;
+    OTG_DIEPTXF0 = (FIFO_EP0_WORDS << 16) | FIFO_RX_WORDS;
+    OTG_DIEPTXF(1u) = (FIFO_DATA_WORDS << 16) | (FIFO_RX_WORDS + FIFO_EP0_WORDS);
+    OTG_DIEPTXF(2u) = (FIFO_NOTIFY_WORDS << 16) | (FIFO_RX_WORDS + FIFO_EP0_WORDS + FIFO_DATA_WORDS);
+    usb_flush_fifos();
+
+    OTG_DIEPMSK = EPINT_XFRC;
+    OTG_DOEPMSK = EPINT_XFRC | EPINT_STUP;
+    OTG_GINTSTS = 0xFFFFFFFFu;
+    OTG_GINTMSK = GINT_RXFLVL | GINT_USBSUSP | GINT_USBRST | GINT_ENUMDNE
+                | GINT_IEPINT | GINT_OEPINT | GINT_WKUPINT;
+    OTG_GAHBCFG = GAHBCFG_GINTMSK;
+
+    interrupt_Config(IRQ_NO_OTG_FS, ENABLE);
+    OTG_DCTL &= ~DCTL_SDIS;                 /* D+ pull-up on: the host sees us */
+    return true;
+}
+
+void usb_hw_set_address(uint8_t address)
+{
+    OTG_DCFG = (OTG_DCFG & ~DCFG_DAD_MASK) | ((uint32_t)address << DCFG_DAD_POS);
+}
+
+void usb_hw_ep_open(uint8_t ep_addr, uint8_t type, uint16_t max_packet)
+{
+    uint8_t  n   = USB_EP_NUM(ep_addr);
+    uint32_t ctl = EPCTL_USBAEP | EPCTL_SD0PID | ((uint32_t)type << EPCTL_EPTYP_POS) | max_packet;
+
+    if (n == 0u || n >= OTG_EPS) return;    /* EP0 is set up by the bus reset */
+
+    if (ep_addr & USB_EP_IN)
+    {
+        OTG_DIEPCTL(n) = ctl | ((uint32_t)n << EPCTL_TXFNUM_POS) | EPCTL_SNAK;
+        OTG_DAINTMSK  |= (1u << n);
+    }
+    else
+    {
+        OTG_DOEPCTL(n) = ctl | EPCTL_SNAK;
+        OTG_DAINTMSK  |= (1u << (16u + n));
+    }
+}
+
+void usb_hw_ep_stall(uint8_t ep_addr)
+{
+    uint8_t n = USB_EP_NUM(ep_addr);
+
+    /* EP0 stalls clear themselves on the next SETUP */
+    if (ep_addr & USB_EP_IN) OTG_DIEPCTL(n) |= EPCTL_STALL;
+    else                     OTG_DOEPCTL(n) |= EPCTL_STALL;
+}
+
+/* A cleared halt restarts the data toggle at DATA0 (USB 2.0 9.4.5) */
+void usb_hw_ep_clear_stall(uint8_t ep_addr)
+{
+    uint8_t n = USB_EP_NUM(ep_addr);
+
+    if (ep_addr & USB_EP_IN) OTG_DIEPCTL(n) = (OTG_DIEPCTL(n) & ~EPCTL_STALL) | EPCTL_SD0PID;
+    else                     OTG_DOEPCTL(n) = (OTG_DOEPCTL(n) & ~EPCTL_STALL) | EPCTL_SD0PID;
+}
+
+void usb_hw_ep_write(uint8_t ep_addr, const uint8_t *data, uint16_t len)
+{
+    uint8_t n = USB_EP_NUM(ep_addr);
+
+    OTG_DIEPTSIZ(n) = TSIZ_PKTCNT_1 | len;
+    OTG_DIEPCTL(n) |= EPCTL_EPENA | EPCTL_CNAK;
+
+    /* one packet per endpoint in flight, so the FIFO always has room */
+    for (uint16_t i = 0u; i < len; i += 4u)
+    {
+        uint32_t w = 0u;
+        uint16_t k = (uint16_t)(len - i);
+        memcpy(&w, data + i, (k < 4u) ? k : 4u);
+        OTG_FIFO(n) = w;
+    }
+}
+
+void usb_hw_ep_read_arm(uint8_t ep_addr, uint8_t *buf, uint16_t len)
+{
+    uint8_t n = USB_EP_NUM(ep_addr);
+
+    s_out_buf[n] = buf;
+    s_out_len[n] = 0u;
+
+    OTG_DOEPTSIZ(n) = TSIZ_PKTCNT_1 | len | ((n == 0u) ? DOEPTSIZ0_STUPCNT_3 : 0u);
+    OTG_DOEPCTL(n) |= EPCTL_EPENA | EPCTL_CNAK;
+}
+
+uint32_t usb_hw_device_id(void)
+{
+    return UID_BASE[0] ^ UID_BASE[1] ^ UID_BASE[2];
+}
+
+void usb_hw_poll(void)
+{
+    /* the controller moves packets from OTG_FS_IRQHandler */
+}
+
+/* ================================================================== */
+/*  Interrupt handler                                                 */
+/* ================================================================== */
+
+void OTG_FS_IRQHandler(void)
+{
+    uint32_t entry = irq_profile_enter();
+    uint32_t sts   = OTG_GINTSTS & OTG_GINTMSK;
+
+    if (sts & GINT_USBRST)
+    {
+        OTG_GINTSTS = GINT_USBRST;
+        usb_on_bus_reset();
+    }
+    if (sts & GINT_ENUMDNE)
+    {
+        OTG_GINTSTS     = GINT_ENUMDNE;
+        OTG_DIEPCTL(0u) &= ~0x3u;           /* MPSIZ 0 = 64 bytes */
+        OTG_DCTL        |= DCTL_CGINAK;
+    }
+    while (OTG_GINTSTS & GINT_RXFLVL)
+    {
+        usb_on_rx_level();
+    }
+    if (sts & GINT_OEPINT) usb_on_out_ep();
+    if (sts & GINT_IEPINT) usb_on_in_ep();
+    if (sts & GINT_USBSUSP)
+    {
+        OTG_GINTSTS = GINT_USBSUSP;
+        usb_dev_on_suspend(true);
+    }
+    if (sts & GINT_WKUPINT)
+    {
+        OTG_GINTSTS = GINT_WKUPINT;
+        usb_dev_on_suspend(false);
+    }
+
+    irq_profile_exit(IRQ_SRC_OTG_FS, entry, 0u);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file test_check.h
+ * @brief Check macros shared by the interface host tests and the host tools
+ *
+ * Unity ships with embedded-foundation and stays inside its own test
+ * tree. These tests link only interface_host (or a stub set), so they
+ * use this small header instead.
+ *
+ *   CHECK(cond, what)     report a failure and carry on
+ *   REQUIRE(cond, what)   report a failure and return from the test function
+ *   check_fail(fmt, ...)  report a failure with a formatted message
+ *
+ * Define CHECK_VERBOSE before the include to print every passing check.
+ * main() ends with `return check_summary("name");`.
+ *
+ * One include per executable: the failure flag is file-static.
+ */
+
+#ifndef TESTS_TEST_CHECK_H_
+#define TESTS_TEST_CHECK_H_
+
+#include <stdarg.h>
+#include <stdio.h>
+
+static int s_check_failed = 0;
+
+static void check_fail(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    fputs("FAIL: ", stderr);
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+    va_end(ap);
+    s_check_failed = 1;
+}
+
+#ifdef CHECK_VERBOSE
+#define CHECK_PASSED(what)  printf("ok    %s\n", what)
+#else
+#define CHECK_PASSED(what)  ((void)0)
+#endif
+
+#define CHECK(cond, what)                                                   \
+    do {                                                                    \
+        if (!(cond)) check_fail("%s", what);                                \
+        else         CHECK_PASSED(what);                                    \
+    } while (0)
+
+#define REQUIRE(cond, what)                                                 \
+    do {                                                                    \
+        if (!(cond)) { check_fail("%s", what); return; }                    \
+        CHECK_PASSED(what);                                                 \
+    } while (0)
+
+static inline int check_failed(void)
+{
+    return s_check_failed;
+}
+
+static inline int check_summary(const char *name)
+{
+    if (s_check_failed) fprintf(stderr, "%s: FAILED\n", name);
+    else                printf("%s: all checks passed\n", name);
+    return s_check_failed;
+}
+
+#endif /* TESTS_TEST_CHECK_H_ */
@@ -0,0 +1,147 @@
+/**
+ * @file test_comm.c
+ * @brief comm_sendv / comm_send_owned dispatch on the host
+ *
+ * Links interface_comm.c against capturing protocol stubs: UART2 has a
+ * native sendv, I2C1 only send(), so both sendv paths are covered.
+ * comm_send_owned must send first and release exactly once, also when
+ * the comm id is bad.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test_check.h"
+#include "interface_comm.h"
+
+
+/* ------------------------------------------------------------------ */
+/*  Protocol stubs                                                    */
+/* ------------------------------------------------------------------ */
+
+static uint8_t  s_wire[256];
+static uint32_t s_wire_len;
+static uint32_t s_send_calls;
+static uint32_t s_sendv_calls;
+
+static void capture(const uint8_t *data, uint32_t len)
+{
+    if (s_wire_len + len > sizeof(s_wire)) return;
+    memcpy(&s_wire[s_wire_len], data, len);
+    s_wire_len += len;
+}
+
+static void reset(void)
+{
+    s_wire_len = 0u;
+    s_send_calls = 0u;
+    s_sendv_calls = 0u;
+}
+
+void uart2_protocol_init(void) {}
+void uart2_protocol_send(uint8_t *data, uint32_t len) { s_send_calls++; capture(data, len); }
+void uart2_protocol_sendv(const comm_iovec_t *iov, uint8_t count)
+{
+    s_sendv_calls++;
+    for (uint8_t i = 0u; i < count; i++) capture(iov[i].base, iov[i].len);
+}
+uint8_t uart2_protocol_receive(uint8_t *buffer, uint32_t len) { (void)buffer; (void)len; return 0u; }
+uint8_t uart2_protocol_data_available(void) { return 0u; }
+
+void i2c1_protocol_init(void) {}
+void i2c1_protocol_send(uint8_t *data, uint32_t len) { s_send_calls++; capture(data, len); }
+uint8_t i2c1_protocol_receive(uint8_t *buffer, uint32_t len) { (void)buffer; (void)len; return 0u; }
+
+void usb_cdc_protocol_init(void) {}
+void usb_cdc_protocol_send(uint8_t *data, uint32_t len) { s_send_calls++; capture(data, len); }
+void usb_cdc_protocol_sendv(const comm_iovec_t *iov, uint8_t count)
+{
+    s_sendv_calls++;
+    for (uint8_t i = 0u; i < count; i++) capture(iov[i].base, iov[i].len);
+}
+uint8_t usb_cdc_protocol_receive(uint8_t *buffer, uint32_t len) { (void)buffer; (void)len; return 0u; }
+uint8_t usb_cdc_protocol_data_available(void) { return 0u; }
+
+/* ------------------------------------------------------------------ */
+/*  Release hook                                                      */
+/* ------------------------------------------------------------------ */
+
+static void    *s_released;
+static uint32_t s_release_calls;
+static uint32_t s_wire_at_release;
+
+static void release(void *block)
+{
+    s_released = block;
+    s_release_calls++;
+    s_wire_at_release = s_wire_len;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Checks                                                            */
+/* ------------------------------------------------------------------ */
+
+static const uint8_t s_hdr[] = { 0xA5, 0x01, 0x02 };
+static const uint8_t s_body[] = { 'h', 'e', 'l', 'l', 'o' };
+static const uint8_t s_crc[] = { 0x34, 0x12 };
+static const uint8_t s_expect[] = { 0xA5, 0x01, 0x02, 'h', 'e', 'l', 'l', 'o', 0x34, 0x12 };
+
+static void test_sendv_native(void)
+{
+    const comm_iovec_t iov[] = { { s_hdr, sizeof(s_hdr) }, { s_body, sizeof(s_body) }, { s_crc, sizeof(s_crc) } };
+
+    reset();
+    comm_sendv(0u, iov, 3u);
+    CHECK(s_sendv_calls == 1u && s_send_calls == 0u, "native sendv used once");
+    CHECK(s_wire_len == sizeof(s_expect) && memcmp(s_wire, s_expect, sizeof(s_expect)) == 0, "native sendv order");
+}
+
+static void test_sendv_fallback(void)
+{
+    const comm_iovec_t iov[] = { { s_hdr, sizeof(s_hdr) }, { s_body, 0u }, { s_body, sizeof(s_body) }, { s_crc, sizeof(s_crc) } };
+
+    reset();
+    comm_sendv(1u, iov, 4u);
+    CHECK(s_sendv_calls == 0u && s_send_calls == 3u, "fallback: one send per non-empty segment");
+    CHECK(s_wire_len == sizeof(s_expect) && memcmp(s_wire, s_expect, sizeof(s_expect)) == 0, "fallback order");
+
+    reset();
+    comm_sendv(1u, iov, 0u);
+    comm_sendv(1u, NULL, 2u);
+    comm_sendv(200u, iov, 4u);
+    CHECK(s_send_calls == 0u && s_wire_len == 0u, "empty list, NULL list, bad id send nothing");
+}
+
+static void test_send_owned(void)
+{
+    static uint8_t block[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    reset();
+    s_release_calls = 0u;
+    s_released = NULL;
+    comm_send_owned(0u, block, sizeof(block), release);
+    CHECK(s_wire_len == sizeof(block) && memcmp(s_wire, block, sizeof(block)) == 0, "owned block sent");
+    CHECK(s_release_calls == 1u && s_released == block, "owned block released once");
+    CHECK(s_wire_at_release == sizeof(block), "release runs after the send");
+
+    reset();
+    s_release_calls = 0u;
+    comm_send_owned(200u, block, sizeof(block), release);
+    CHECK(s_wire_len == 0u && s_release_calls == 1u, "bad id still releases");
+
+    s_release_calls = 0u;
+    comm_send_owned(0u, NULL, 4u, release);
+    CHECK(s_wire_len == 0u && s_release_calls == 0u, "NULL block: no send, no release");
+
+    comm_send_owned(0u, block, sizeof(block), NULL);
+    CHECK(s_wire_len == sizeof(block), "NULL release still sends");
+}
+
+int main(void)
+{
+    test_sendv_native();
+    test_sendv_fallback();
+    test_send_owned();
+
+    return check_summary("comm");
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_crc32.c
+ * @brief crc32.c / crc32_host.c against tools/image_crc.py
+ *
+ *   test_crc32 [sealed.bin]
+ *
+ * Vectors come from image_crc.py's crc32_words(); 0xC704DD7B for one
+ * zero word is also the STM32 CRC unit's documented result. Checks the
+ * residue-0 seal property and that split points do not change the
+ * streaming result. With a path argument, writes a sealed image that
+ * ctest then verifies with image_crc.py --check.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test_check.h"
+#include "interface_crc.h"
+
+
+#define IMAGE_BYTES     1024u
+
+static uint8_t s_image[IMAGE_BYTES + 4u];
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void test_vectors(void)
+{
+    static const uint32_t zero = 0u;
+
+    CHECK(crc32("12345678", 8u) == 0xFEFC54F9u, "crc32(\"12345678\")");
+    CHECK(crc32("123456789", 9u) == 0xAFF19057u, "crc32(\"123456789\"), tail zero-padded");
+    CHECK(crc32_words(CRC32_INIT, &zero, 1u) == 0xC704DD7Bu, "one zero word");
+    CHECK(crc32_words(CRC32_INIT, &zero, 0u) == CRC32_INIT, "no words leaves the init value");
+
+    for (uint32_t i = 0u; i < IMAGE_BYTES; i++) s_image[i] = (uint8_t)i;
+    CHECK(crc32(s_image, IMAGE_BYTES) == 0x8ADA4578u, "1 KB ramp");
+}
+
+static void test_residue(void)
+{
+    uint32_t crc = crc32(s_image, IMAGE_BYTES);
+    put_le32(&s_image[IMAGE_BYTES], crc);
+    CHECK(crc32(s_image, IMAGE_BYTES + 4u) == 0u, "residue over data + LE crc is 0");
+
+    s_image[17] ^= 0x01u;
+    CHECK(crc32(s_image, IMAGE_BYTES + 4u) != 0u, "flipped bit breaks the residue");
+    s_image[17] ^= 0x01u;
+}
+
+static void test_streaming(void)
+{
+    uint32_t whole = crc32(s_image, IMAGE_BYTES);
+
+    for (size_t split = 0u; split <= 13u; split++)
+    {
+        crc32_ctx_t ctx;
+        crc32_begin(&ctx);
+        crc32_update(&ctx, s_image, split);
+        crc32_update(&ctx, &s_image[split], 3u);
+        crc32_update(&ctx, &s_image[split + 3u], IMAGE_BYTES - split - 3u);
+        REQUIRE(crc32_final(&ctx) == whole, "streaming result independent of split points");
+    }
+}
+
+static void write_sealed(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    REQUIRE(f != NULL, "open sealed image for writing");
+    CHECK(fwrite(s_image, 1u, IMAGE_BYTES + 4u, f) == IMAGE_BYTES + 4u, "write sealed image");
+    fclose(f);
+}
+
+int main(int argc, char **argv)
+{
+    test_vectors();
+    test_residue();
+    test_streaming();
+    if (argc > 1) write_sealed(argv[1]);
+
+    return check_summary("crc32");
+}
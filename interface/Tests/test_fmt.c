@@ -0,0 +1,186 @@
+/**
+ * @file test_fmt.c
+ * @brief fmt.c (the uprint formatter) against the host C library
+ *
+ * Every standard conversion fmt supports is run through both fmt_vformat
+ * and vsnprintf and the strings must match: flags, width, precision,
+ * '*' arguments, length modifiers hh h l ll z, negative values and 64-bit
+ * limits. %q has no libc counterpart and is checked against fixed strings.
+ *
+ * Not supported by fmt, and checked as such: %o (and any other unknown
+ * conversion) is printed back literally without consuming an argument;
+ * %f %e %g consume a double and print '?'.
+ */
+
+#include <limits.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "test_check.h"
+#include "fmt.h"
+
+#define OUT_MAX     256u
+
+typedef struct
+{
+    char     buf[OUT_MAX];
+    uint32_t pos;
+    uint32_t calls;
+} capture_t;
+
+static void capture(void *ctx, const char *data, uint32_t len)
+{
+    capture_t *c = (capture_t *)ctx;
+    c->calls++;
+    while (len-- && c->pos + 1u < OUT_MAX) c->buf[c->pos++] = *data++;
+    c->buf[c->pos] = '\0';
+}
+
+/* Formats with fmt and with vsnprintf; both results and lengths must match */
+__attribute__((format(printf, 1, 2)))
+static void same(const char *format, ...)
+{
+    char      want[OUT_MAX];
+    capture_t got = { {0}, 0u, 0u };
+    va_list   ap;
+
+    va_start(ap, format);
+    int want_len = vsnprintf(want, sizeof(want), format, ap);
+    va_end(ap);
+
+    va_start(ap, format);
+    uint32_t got_len = fmt_vformat(capture, &got, format, ap);
+    va_end(ap);
+
+    if (strcmp(got.buf, want) != 0 || got_len != (uint32_t)want_len)
+    {
+        check_fail("\"%s\": got \"%s\" (%u), libc \"%s\" (%d)", format, got.buf, got_len, want, want_len);
+    }
+}
+
+/* For %q and the unsupported cases, where libc has no reference */
+static void expect(const char *want, const char *format, ...)
+{
+    capture_t got = { {0}, 0u, 0u };
+    va_list   ap;
+
+    va_start(ap, format);
+    (void)fmt_vformat(capture, &got, format, ap);
+    va_end(ap);
+
+    if (strcmp(got.buf, want) != 0)
+    {
+        check_fail("\"%s\": got \"%s\", want \"%s\"", format, got.buf, want);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Checks                                                            */
+/* ------------------------------------------------------------------ */
+
+static void test_flags_width(void)
+{
+    same("[%5d|%-5d|%05d|%+d|% d]", 42, 42, 42, 42, 42);
+    same("[%+5d|%-+5d|% 05d|%+05d]", -7, 7, 7, -7);
+    same("[%*d|%*d|%-*d]", 6, 5, -6, 5, 6, 5);
+    same("[%5u|%-5u|%05u]", 7u, 7u, 7u);
+    same("[%c|%3c|%-3c]", 'a', 'b', 'c');
+    same("[%s|%10s|%-10s|%*s]", "abc", "abc", "abc", 4, "xy");
+    same("[%%|100%%]");
+}
+
+static void test_precision(void)
+{
+    same("[%.3d|%8.3d|%-8.3d]", 7, -7, 7);
+    expect("[     007]", "[%08.3d]", 7);         /* '0' is ignored with a precision, as in C */
+    same("[%.0d|%.0u|%.0x|%5.0d]", 0, 0u, 0u, 0);
+    same("[%.5u|%.2u|%.*d|%.*d]", 42u, 12345u, 4, 9, -1, 9);
+    same("[%.2s|%.*s|%-6.3s]", "abcdef", 1, "xyz", "abcdef");
+    same("[%.4x|%#.4x|%#8.4X]", 0xABu, 0xABu, 0xABu);
+}
+
+static void test_hex_pointer(void)
+{
+    same("[%x|%X|%#x|%#X|%#08x|%#x]", 0xbeefu, 0xBEEFu, 255u, 255u, 255u, 0u);
+    same("[%x|%lx|%llx|%llX]", UINT_MAX, ULONG_MAX, 0x0123456789abcdefULL, 0xFEDCBA9876543210ULL);
+
+    int x;
+    same("[%p]", (void *)&x);
+}
+
+static void test_lengths(void)
+{
+    same("[%hd|%hu|%hhd|%hhu]", 70000, 70000u, 200, 300u);
+    same("[%ld|%lu|%li]", -123456L, 4000000000UL, LONG_MIN);
+    same("[%zu|%zd]", (size_t)123456789u, (ptrdiff_t)-42);
+}
+
+static void test_negative_and_64bit(void)
+{
+    same("[%d|%i|%d|%d]", -1, INT_MIN, INT_MAX, 0);
+    same("[%lld|%lld|%llu]", LLONG_MIN, LLONG_MAX, ULLONG_MAX);
+
+    /* around the 32-bit fast path and the 9-digit 64-bit steps */
+    same("[%lld|%lld|%llu]", 4294967295LL, 4294967296LL, 1000000000ULL);
+    same("[%lld|%lld|%llu]", -4294967296LL, 999999999999LL, 1000000000000000000ULL);
+    same("[%20lld|%-22lld|%+025lld]", -1234567890123LL, 42LL, -9876543210LL);
+}
+
+static void test_chunking(void)
+{
+    /* longer than FMT_CHUNK_SIZE: the sink runs more than once */
+    same("%-40s|%40d|", "left", -123);
+
+    capture_t c = { {0}, 0u, 0u };
+    (void)fmt_format(capture, &c, "%-70s", "x");
+    CHECK(c.calls == (70u + FMT_CHUNK_SIZE - 1u) / FMT_CHUNK_SIZE, "one sink call per full chunk");
+}
+
+static void test_snprintf(void)
+{
+    char buf[8];
+
+    uint32_t n = fmt_snprintf(buf, sizeof(buf), "%d-%s", 12345, "abcdef");
+    CHECK(n == 12u && strcmp(buf, "12345-a") == 0, "fmt_snprintf truncates like snprintf");
+    CHECK(fmt_snprintf(NULL, 0u, "%u", 1234u) == 4u, "fmt_snprintf NULL buffer counts");
+}
+
+static void test_fixed_point(void)
+{
+    expect("12.345",          "%.3q", 12345);
+    expect("-0.05",           "%.2lq", -5L);
+    expect("-1234567890.123", "%.3llq", -1234567890123LL);
+    expect("42",              "%q", 42);
+    expect("0.000000007",     "%.9q", 7);
+    expect("    3.14|",       "%8.2q|", 314);
+    expect("3.14    |",       "%-8.2q|", 314);
+    expect("-0003.14",        "%08.2q", -314);
+    expect("+0.5| 0.5",       "%+.1q|% .1q", 5, 5);
+    expect("-2147483.648",    "%.3q", INT_MIN);
+}
+
+static void test_unsupported(void)
+{
+    /* %o is unsupported: printed literally, its argument is not consumed */
+    expect("%o|5", "%o|%d", 5);
+    expect("?|7", "%f|%d", 1.5, 7);
+    expect("?", "%.2e", 2.0);
+}
+
+int main(void)
+{
+    test_flags_width();
+    test_precision();
+    test_hex_pointer();
+    test_lengths();
+    test_negative_and_64bit();
+    test_chunking();
+    test_snprintf();
+    test_fixed_point();
+    test_unsupported();
+
+    return check_summary("fmt");
+}
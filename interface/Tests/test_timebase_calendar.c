@@ -0,0 +1,127 @@
+/**
+ * @file test_timebase_calendar.c
+ * @brief timebase_us_from_datetime / timebase_us_to_datetime on the host
+ *
+ * Fixed points are checked against Python's datetime (seconds since
+ * 2000-01-01). Every day of the RTC range 2000-2099 is also round-tripped.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test_check.h"
+#include "interface_timebase_us.h"
+
+
+static RTC_DateTime_t dt(uint8_t year, uint8_t month, uint8_t date,
+                         uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    RTC_DateTime_t d;
+    memset(&d, 0, sizeof(d));
+    d.date.year    = year;
+    d.date.month   = month;
+    d.date.date    = date;
+    d.time.hours   = hours;
+    d.time.minutes = minutes;
+    d.time.seconds = seconds;
+    return d;
+}
+
+static int same(const RTC_DateTime_t *a, const RTC_DateTime_t *b)
+{
+    return a->date.year == b->date.year && a->date.month == b->date.month &&
+           a->date.date == b->date.date && a->time.hours == b->time.hours &&
+           a->time.minutes == b->time.minutes && a->time.seconds == b->time.seconds;
+}
+
+static void test_fixed_points(void)
+{
+    static const struct
+    {
+        uint8_t  y, mo, d, h, mi, s;
+        uint64_t secs;
+    } v[] = {
+        {  0u,  1u,  1u,  0u,  0u,  0u,          0ull },
+        {  0u,  2u, 29u,  0u,  0u,  0u,    5097600ull },     /* leap day, century leap year */
+        {  1u,  3u,  1u,  0u,  0u,  0u,   36720000ull },     /* first non-leap March */
+        { 24u,  2u, 29u, 12u, 34u, 56u,  762525296ull },
+        { 99u, 12u, 31u, 23u, 59u, 59u, 3155759999ull },     /* end of the RTC range */
+    };
+
+    for (size_t i = 0u; i < sizeof(v) / sizeof(v[0]); i++)
+    {
+        RTC_DateTime_t in = dt(v[i].y, v[i].mo, v[i].d, v[i].h, v[i].mi, v[i].s);
+        RTC_DateTime_t out;
+
+        CHECK(timebase_us_from_datetime(&in) == v[i].secs * TIMEBASE_US_PER_SEC, "from_datetime fixed point");
+        timebase_us_to_datetime(v[i].secs * TIMEBASE_US_PER_SEC + 999999u, &out);
+        CHECK(same(&in, &out), "to_datetime fixed point (sub-second truncated)");
+    }
+}
+
+static void test_every_day(void)
+{
+    static const uint8_t mdays[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    uint64_t expect = 0u;
+
+    for (uint8_t y = 0u; y < 100u; y++)
+    {
+        for (uint8_t m = 1u; m <= 12u; m++)
+        {
+            uint8_t n = (uint8_t)(mdays[m - 1u] + ((m == 2u && y % 4u == 0u) ? 1u : 0u));
+            for (uint8_t d = 1u; d <= n; d++)
+            {
+                RTC_DateTime_t in = dt(y, m, d, 23u, 59u, 59u);
+                RTC_DateTime_t out;
+                uint64_t us = timebase_us_from_datetime(&in);
+
+                if (us != (expect + 86399u) * TIMEBASE_US_PER_SEC)
+                {
+                    check_fail("day count at %02u-%02u-%02u", y, m, d);
+                    return;
+                }
+                timebase_us_to_datetime(us, &out);
+                if (!same(&in, &out))
+                {
+                    check_fail("round trip at %02u-%02u-%02u", y, m, d);
+                    return;
+                }
+                expect += 86400u;
+            }
+        }
+    }
+}
+
+static void test_invalid_input(void)
+{
+    RTC_DateTime_t zero = dt(5u, 0u, 0u, 0u, 0u, 0u);       /* unset month/day read as Jan 1 */
+    RTC_DateTime_t jan1 = dt(5u, 1u, 1u, 0u, 0u, 0u);
+
+    CHECK(timebase_us_from_datetime(&zero) == timebase_us_from_datetime(&jan1), "month/day 0 clamp to 1");
+    CHECK(timebase_us_from_datetime(NULL) == 0u, "NULL from_datetime");
+    timebase_us_to_datetime(0u, NULL);                      /* must not crash */
+}
+
+static void test_wall_clock(void)
+{
+    RTC_DateTime_t at = dt(24u, 6u, 30u, 23u, 59u, 58u);
+    RTC_DateTime_t want = dt(24u, 7u, 1u, 0u, 0u, 1u);
+    RTC_DateTime_t now;
+
+    timebase_us_init();
+    timebase_us_host_set(5000000u);
+    timebase_us_sync(&at);
+    timebase_us_host_advance(3u * TIMEBASE_US_PER_SEC);
+    timebase_us_now(&now);
+    CHECK(same(&now, &want), "sync + advance crosses midnight and month end");
+}
+
+int main(void)
+{
+    test_fixed_points();
+    test_every_day();
+    test_invalid_input();
+    test_wall_clock();
+
+    return check_summary("timebase_calendar");
+}
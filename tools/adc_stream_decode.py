@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Decode the binary ADC telemetry stream (see app/Inc/telemetry.h).
+
+    adc_stream_decode.py capture.bin -o samples.csv
+    adc_stream_decode.py /dev/ttyACM0 --baud 115200 --seconds 10 -o samples.csv
+    adc_stream_decode.py capture.bin --record-out inputs.rec   (rec_dump -> tools/replay)
+
+Reading from a serial port needs pyserial. Text CLI output interleaved
+with the frames is skipped.
+
+A packet's t_us is taken when the packet is built, just after its last
+sample. Earlier samples are placed one sample period apart before it.
+The period comes from --rate (the stream_rate setting), or else from
+the packet timestamps over the whole capture.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+SYNC = b"\xA5\x5A"
+TYPE_ADC = 0x01
+TYPE_LOOP = 0x02
+TYPE_RECORD = 0x03
+HEADER = 6
+TRAILER = 2
+
+
+def fletcher16(data):
+    s1 = s2 = 0
+    for b in data:
+        s1 = (s1 + b) % 255
+        s2 = (s2 + s1) % 255
+    return (s2 << 8) | s1
+
+
+def frames(buf):
+    """Yield (type, seq, payload, wire_len) and drop everything else."""
+    i = 0
+    while True:
+        i = buf.find(SYNC, i)
+        if i < 0 or i + HEADER > len(buf):
+            return
+        ftype, seq, length = struct.unpack_from("<BBH", buf, i + 2)
+        end = i + HEADER + length + TRAILER
+        if end > len(buf):
+            return
+        (csum,) = struct.unpack_from("<H", buf, end - TRAILER)
+        if fletcher16(buf[i + 2:end - TRAILER]) == csum:
+            yield ftype, seq, bytes(buf[i + HEADER:end - TRAILER]), end - i
+            i = end
+        else:
+            i += 1
+
+
+def varints(data, pos):
+    value = shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+
+
+def decode_adc(payload):
+    first_index, t_us, overruns, count, first = struct.unpack_from("<IIHBH", payload, 0)
+    samples = [first]
+    pos = 13
+    for _ in range(count - 1):
+        zz, pos = varints(payload, pos)
+        samples.append(samples[-1] + ((zz >> 1) ^ -(zz & 1)))
+    return first_index, t_us, overruns, samples
+
+
+def read_input(args):
+    if args.input.startswith("/dev/") or args.input.upper().startswith("COM"):
+        import serial
+        data = bytearray()
+        with serial.Serial(args.input, args.baud, timeout=0.1) as port:
+            end = time.monotonic() + args.seconds
+            while time.monotonic() < end:
+                data += port.read(4096)
+        return data
+    with open(args.input, "rb") as f:
+        return bytearray(f.read())
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("input", help="capture file or serial port")
+    ap.add_argument("-o", "--output", default="-", help="CSV output (default stdout)")
+    ap.add_argument("--baud", type=int, default=115200)
+    ap.add_argument("--seconds", type=float, default=10.0)
+    ap.add_argument("--record-out", help="write rec_dump frames to this file")
+    ap.add_argument("--rate", type=float, help="stream rate in Hz (default: estimated from the capture)")
+    args = ap.parse_args()
+
+    data = read_input(args)
+
+    nframes = lost = nsamples = wire = 0
+    last_seq = None
+    overruns = 0
+    record = bytearray()
+    packets = []
+
+    for ftype, seq, payload, wire_len in frames(data):
+        if last_seq is not None:
+            lost += (seq - last_seq - 1) & 0xFF
+        last_seq = seq
+        nframes += 1
+
+        if ftype == TYPE_RECORD:
+            record += payload
+        if ftype != TYPE_ADC:
+            continue
+
+        index, t_us, overruns, samples = decode_adc(payload)
+        packets.append((index, t_us, samples))
+        nsamples += len(samples)
+        wire += wire_len
+
+    # Anchor each packet at its last sample, which is when t_us was taken
+    rate = None
+    if len(packets) >= 2:
+        first, last = packets[0], packets[-1]
+        span_us = (last[1] - first[1]) & 0xFFFFFFFF
+        span_samples = (last[0] + len(last[2])) - (first[0] + len(first[2]))
+        if span_us:
+            rate = span_samples * 1e6 / span_us
+    period_us = 1e6 / (args.rate or rate) if (args.rate or rate) else 0.0
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    out.write("index,t_us,raw,mv\n")
+    for index, t_us, samples in packets:
+        n = len(samples)
+        for k, raw in enumerate(samples):
+            t = (t_us - int(round((n - 1 - k) * period_us))) & 0xFFFFFFFF
+            out.write("%d,%d,%d,%d\n" % (index + k, t, raw, raw * 3300 // 4095))
+    if out is not sys.stdout:
+        out.close()
+
+    rep = sys.stderr
+    if args.record_out:
+        with open(args.record_out, "wb") as f:
+            f.write(record)
+        rep.write("record log: %d bytes -> %s\n" % (len(record), args.record_out))
+    rep.write("frames: %d  lost: %d  samples: %d  fifo overruns: %d\n" % (nframes, lost, nsamples, overruns))
+    if rate:
+        rep.write("achieved rate: %.1f samples/s\n" % rate)
+    if wire:
+        rep.write("compression: %d raw bytes -> %d wire bytes (%.2fx)\n" % (nsamples * 2, wire, nsamples * 2.0 / wire))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,85 @@
+/**
+ * @file control_sim.c
+ * @brief Tune the control loop PID against a first-order plant on the host
+ *
+ *   control_sim kp ki kd [rate_hz] [tau_ms] [setpoint] [duration_ms] > step.csv
+ *
+ * Gains are the same per-sample values passed to control_start() (as
+ * floats here, converted with PID_Q16). The plant is an RC-like first
+ * order lag from PWM duty to ADC counts with one sample of transport
+ * delay, matching the pipelined ADC read in the loop ISR. PWM and ADC
+ * are quantised like on the board (1000 compare counts, 12-bit ADC).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "control_pid.h"
+
+#define SIM_PWM_COUNTS      1000        /* PWM0_RESOLUTION */
+#define SIM_ADC_MAX         4095
+#define SIM_SETTLE_BAND     0.02        /* +-2 % of setpoint */
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s kp ki kd [rate_hz] [tau_ms] [setpoint] [duration_ms]\n", argv[0]);
+        return 2;
+    }
+
+    double   kp       = atof(argv[1]);
+    double   ki       = atof(argv[2]);
+    double   kd       = atof(argv[3]);
+    uint32_t rate_hz  = (argc > 4) ? (uint32_t)atoi(argv[4]) : 10000u;
+    double   tau_ms   = (argc > 5) ? atof(argv[5]) : 5.0;
+    int32_t  setpoint = (argc > 6) ? atoi(argv[6]) : 2048;
+    double   dur_ms   = (argc > 7) ? atof(argv[7]) : 50.0;
+
+    pid_q16_t pid = {
+        .kp      = PID_Q16(kp),
+        .ki      = PID_Q16(ki),
+        .kd      = PID_Q16(kd),
+        .out_min = 0,
+        .out_max = SIM_PWM_COUNTS,
+    };
+    pid_q16_reset(&pid, 0);
+
+    double   dt    = 1.0 / rate_hz;
+    double   alpha = 1.0 - exp(-dt / (tau_ms / 1000.0));
+    double   y     = 0.0;           /* plant output, ADC counts */
+    int32_t  meas  = 0;             /* sample taken last period */
+    uint32_t steps = (uint32_t)(dur_ms / 1000.0 / dt);
+
+    double   peak = 0.0, iae = 0.0;
+    double   settle_ms = -1.0;
+
+    printf("t_ms,setpoint,meas,out\n");
+    for (uint32_t k = 0u; k < steps; k++)
+    {
+        int32_t out = pid_q16_update(&pid, setpoint, meas);
+
+        double target = (double)out / SIM_PWM_COUNTS * SIM_ADC_MAX;
+        y += alpha * (target - y);
+
+        meas = (int32_t)lround(y);
+        if (meas > SIM_ADC_MAX) meas = SIM_ADC_MAX;
+        if (meas < 0) meas = 0;
+
+        double t_ms = k * dt * 1000.0;
+        printf("%.3f,%d,%d,%d\n", t_ms, setpoint, meas, out);
+
+        if (y > peak) peak = y;
+        iae += fabs(setpoint - y) * dt;
+
+        if (fabs(setpoint - y) > SIM_SETTLE_BAND * setpoint) settle_ms = -1.0;
+        else if (settle_ms < 0.0) settle_ms = t_ms;
+    }
+
+    fprintf(stderr, "overshoot: %.1f %%\n", setpoint ? (peak - setpoint) * 100.0 / setpoint : 0.0);
+    if (settle_ms >= 0.0) fprintf(stderr, "settling (2%%): %.2f ms\n", settle_ms);
+    else                  fprintf(stderr, "settling (2%%): not settled\n");
+    fprintf(stderr, "IAE: %.3f counts*s\n", iae);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Seal flash.bin with a CRC-32 trailer for the `crc` CLI command.
+
+    image_crc.py flash.bin            (pad + append, run after every build)
+    image_crc.py flash.bin --check    (verify an already sealed image)
+
+The CRC matches interface_crc.h and the STM32 CRC unit: poly 0x04C11DB7,
+init 0xFFFFFFFF, no reflection, no final XOR, little-endian 32-bit words
+fed MSB first. The image is padded to a whole word with 0xFF (erased
+flash), then the CRC is appended as a little-endian word, so the CRC over
+the sealed file is 0.
+"""
+
+import argparse
+import struct
+import sys
+
+POLY = 0x04C11DB7
+INIT = 0xFFFFFFFF
+
+
+def _table():
+    table = []
+    for i in range(256):
+        c = i << 24
+        for _ in range(8):
+            c = ((c << 1) ^ POLY) if c & 0x80000000 else (c << 1)
+            c &= 0xFFFFFFFF
+        table.append(c)
+    return table
+
+
+TABLE = _table()
+
+
+def crc32_words(data, crc=INIT):
+    if len(data) % 4:
+        raise ValueError("length must be a multiple of 4")
+    for (word,) in struct.iter_unpack("<I", data):
+        crc ^= word
+        for _ in range(4):
+            crc = ((crc << 8) & 0xFFFFFFFF) ^ TABLE[crc >> 24]
+    return crc
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("image")
+    ap.add_argument("--check", action="store_true", help="verify instead of sealing")
+    args = ap.parse_args()
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+
+    if args.check:
+        ok = len(data) % 4 == 0 and len(data) >= 4 and crc32_words(data) == 0
+        print("%s: %s" % (args.image, "OK" if ok else "BAD"))
+        return 0 if ok else 1
+
+    data += b"\xFF" * (-len(data) % 4)
+    crc = crc32_words(data)
+    with open(args.image, "wb") as f:
+        f.write(data + struct.pack("<I", crc))
+
+    print("%s: %u bytes, crc %08X" % (args.image, len(data), crc))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
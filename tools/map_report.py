@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""Summarise input sections from a GNU ld map file (app's flash.map).
+
+    map_report.py build/app/flash.map                       (top 30 by size)
+    map_report.py flash.map --match 'fmt|vfprintf|uprint'   (flash footprint of a feature)
+    map_report.py flash.map --by-object                     (totals per object file)
+    map_report.py flash.map --output-section .fast          (what runs from SRAM)
+
+Each line is: region, address, size, input section, object. Region is
+FLASH or RAM from the run address. The total of the listed sections is
+printed last. --output-section also prints the section's run and load
+address, e.g. .fast runs in RAM but loads from FLASH.
+"""
+
+import argparse
+import re
+import sys
+
+FLASH = (0x08000000, 0x08080000)
+RAM = (0x20000000, 0x20020000)
+
+# ' .text.name   0x08001234   0x2a4 lib.a(obj.o)' — name may sit alone on the line before
+ENTRY = re.compile(r"^ (\.\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+NAME_ONLY = re.compile(r"^ (\.\S+)\s*$")
+# '.fast   0x20000100   0x1a4 load address 0x0800abcd' — output section, column 0
+OUTPUT = re.compile(r"^(\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?(?:\s+load address 0x([0-9a-fA-F]+))?\s*$")
+OUTPUT_CONT = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+load address 0x([0-9a-fA-F]+))?\s*$")
+
+
+def region(addr):
+    if FLASH[0] <= addr < FLASH[1]:
+        return "FLASH"
+    if RAM[0] <= addr < RAM[1]:
+        return "RAM"
+    return "-"
+
+
+def output_header(outputs, name, vma, size, lma):
+    vma = int(vma, 16)
+    outputs[name] = (vma, int(size, 16), int(lma, 16) if lma else vma)
+
+
+def parse(path):
+    entries = []
+    outputs = {}
+    in_map = False
+    pending = None
+    out = None
+    out_pending = False
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                in_map = True
+                continue
+            if not in_map:
+                continue
+            m = OUTPUT.match(line)
+            if m:
+                out = m.group(1)
+                out_pending = m.group(2) is None
+                if not out_pending:
+                    output_header(outputs, out, m.group(2), m.group(3), m.group(4))
+                pending = None
+                continue
+            if out_pending:
+                out_pending = False
+                m = OUTPUT_CONT.match(line)
+                if m:
+                    output_header(outputs, out, m.group(1), m.group(2), m.group(3))
+                    continue
+            m = NAME_ONLY.match(line)
+            if m:
+                pending = m.group(1)
+                continue
+            m = ENTRY.match(line)
+            if m:
+                name = m.group(1) or pending
+                pending = None
+                addr, size = int(m.group(2), 16), int(m.group(3), 16)
+                if name is None or size == 0 or "load address" in m.group(4):
+                    continue
+                entries.append((region(addr), addr, size, name, m.group(4).strip(), out))
+            else:
+                pending = None
+    return entries, outputs
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("map")
+    ap.add_argument("--match", help="regex on section name or object")
+    ap.add_argument("--region", choices=["FLASH", "RAM"])
+    ap.add_argument("--output-section", help="only input sections placed in this output section")
+    ap.add_argument("--by-object", action="store_true")
+    ap.add_argument("--top", type=int, default=30, help="rows without --match (0 = all)")
+    args = ap.parse_args()
+
+    entries, outputs = parse(args.map)
+    if args.output_section:
+        entries = [e for e in entries if e[5] == args.output_section]
+        if args.output_section in outputs:
+            vma, size, lma = outputs[args.output_section]
+            print("%s: %u bytes, runs at 0x%08X (%s), loads from 0x%08X (%s)"
+                  % (args.output_section, size, vma, region(vma), lma, region(lma)))
+    if args.match:
+        rx = re.compile(args.match)
+        entries = [e for e in entries if rx.search(e[3]) or rx.search(e[4])]
+    if args.region:
+        entries = [e for e in entries if e[0] == args.region]
+
+    if args.by_object:
+        totals = {}
+        for e in entries:
+            totals[e[4]] = totals.get(e[4], 0) + e[2]
+        rows = sorted(totals.items(), key=lambda kv: -kv[1])
+        for obj, size in rows:
+            print("%8u  %s" % (size, obj))
+    else:
+        rows = sorted(entries, key=lambda e: -e[2])
+        if not args.match and args.top:
+            rows = rows[: args.top]
+        for reg, addr, size, name, obj, _ in rows:
+            print("%-5s 0x%08X %7u  %-40s %s" % (reg, addr, size, name, obj))
+
+    print("total %u bytes in %u sections" % (sum(e[2] for e in entries), len(entries)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,150 @@
+/**
+ * @file replay.c
+ * @brief Replay a recorded input log through ticker, CLI and faults
+ *
+ *   replay capture.rec [-v]
+ *
+ * The log comes from the firmware 'rec_dump' command (extracted with
+ * tools/adc_stream_decode.py --record-out). Board ids match app/Inc/board_config.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interface/interface.h"
+#include "interface_defines.h"
+#include "interface_record.h"
+
+#include "core/uprint.h"
+#include "core/cli.h"
+#include "core/ticker.h"
+#include "core/fault.h"
+#include "shared/pool.h"
+#include "bsp/button.h"
+
+#define REPLAY_IDLE_STEP_US     1000u
+#define REPLAY_BUTTON_IO        INTERFACE_IO_5
+#define REPLAY_BUTTON_UUID      4
+
+static const command_t commands_table[] = {
+    {"help",   cli_help,           "List all commands"},
+};
+
+static void task_button(void)
+{
+    button_update(button_getByUuid(REPLAY_BUTTON_UUID));
+}
+
+static const ticker_task_t replay_tasks[] = {
+    TICKER_TASK(task_button, 10),
+};
+
+static bool detect_overcurrent(void)
+{
+    return button_isPressed(button_getByUuid(REPLAY_BUTTON_UUID));
+}
+
+static void step(void)
+{
+    ticker_update();
+    cli_update();
+    fault_update();
+}
+
+static uint8_t *load(const char *path, uint32_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t *buf = (size > 0) ? malloc((size_t)size) : NULL;
+    if (buf && fread(buf, 1u, (size_t)size, f) != (size_t)size)
+    {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+
+    *len = (uint32_t)size;
+    return buf;
+}
+
+static const char *type_name(uint8_t type)
+{
+    switch (type)
+    {
+        case RECORD_UART_RX:   return "uart";
+        case RECORD_GPIO_LOW:
+        case RECORD_GPIO_HIGH: return "gpio";
+        case RECORD_ADC:       return "adc";
+        default:               return "?";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <log> [-v]\n", argv[0]);
+        return 2;
+    }
+
+    uint32_t len = 0u;
+    uint8_t *log = load(argv[1], &len);
+    if (log == NULL)
+    {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 2;
+    }
+
+    replay_echo_tx(argc > 2 && strcmp(argv[2], "-v") == 0);
+    replay_load(log, len);
+
+    pool_Init();
+    poolBig_Init();
+    uprint_setup(INTERFACE_PROTOCOL_UART2);
+    cli_setup(INTERFACE_PROTOCOL_UART2, (command_t*)commands_table,
+              sizeof(commands_table) / sizeof(commands_table[0]));
+
+    buttonPtr_t button = button_createWithUuid("Button", REPLAY_BUTTON_IO, 10, 500, REPLAY_BUTTON_UUID);
+    if (button != NULL)
+    {
+        button_invertLogic(button);
+    }
+
+    fault_init();
+    const fault_config_t overcurrent_cfg = {
+        .name        = "Overcurrent Out1",
+        .detect      = detect_overcurrent,
+        .recovery_ms = 5000,
+    };
+    (void)fault_register(&overcurrent_cfg);
+
+    ticker_init(replay_tasks, TICKER_TASK_COUNT(replay_tasks));
+
+    replay_report_t rep;
+    bool ok = replay_run(step, REPLAY_IDLE_STEP_US, &rep);
+    free(log);
+
+    printf("\nevents:        %u (%u loop steps)\n", rep.events, rep.steps);
+    printf("virtual span:  %llu us\n", (unsigned long long)rep.span_us);
+    if (rep.events != 0u)
+    {
+        printf("latency avg:   %llu ns\n", (unsigned long long)(rep.busy_ns / rep.events));
+    }
+    printf("latency worst: %u ns (%s)\n", rep.worst_ns, type_name(rep.worst_type));
+    printf("worst budget:  %u.%03u %% of inter-event gap\n",
+           rep.worst_budget_ppm / 10000u, (rep.worst_budget_ppm / 10u) % 1000u);
+    printf("tx bytes:      %u\n", rep.tx_bytes);
+
+    if (!ok)
+    {
+        fprintf(stderr, "log truncated or corrupt\n");
+        return 1;
+    }
+    return 0;
+}
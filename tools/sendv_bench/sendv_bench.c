@@ -0,0 +1,140 @@
+/**
+ * @file sendv_bench.c
+ * @brief Compare comm_sendv with flatten-then-comm_send on the host
+ *
+ *   sendv_bench [frames]
+ *
+ * Sends telemetry-shaped frames (6-byte header, payload, 2-byte trailer)
+ * through interface_comm.c with three paths:
+ *
+ *   sendv     native scatter-gather instance (UART2 slot)
+ *   fallback  instance without sendv, one send() per segment (I2C1 slot)
+ *   flatten   memcpy into a scratch frame, then a single comm_send()
+ *
+ * The protocol stubs store byte by byte into a volatile data register,
+ * like UART_Write, so the sink cost is the same for every path and the
+ * difference is the gather copy and the extra calls. Host ns are only
+ * good for ratios; the copy cost on the target scales with them.
+ */
+
+#define _POSIX_C_SOURCE 199309L     /* clock_gettime */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "interface/interface.h"
+#include "interface_comm.h"
+
+#define FRAME_HEADER    6u
+#define FRAME_TRAILER   2u
+#define PAYLOAD_MAX     256u
+
+/* ------------------------------------------------------------------ */
+/*  Protocol stubs                                                    */
+/* ------------------------------------------------------------------ */
+
+static volatile uint8_t s_dr;
+static uint64_t         s_bytes;
+
+static void sink(const uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0u; i < len; i++) s_dr = data[i];
+    s_bytes += len;
+}
+
+void uart2_protocol_init(void) {}
+void uart2_protocol_send(uint8_t *data, uint32_t len) { sink(data, len); }
+void uart2_protocol_sendv(const comm_iovec_t *iov, uint8_t count)
+{
+    for (uint8_t i = 0u; i < count; i++) sink(iov[i].base, iov[i].len);
+}
+uint8_t uart2_protocol_receive(uint8_t *buffer, uint32_t len) { (void)buffer; (void)len; return 0u; }
+uint8_t uart2_protocol_data_available(void) { return 0u; }
+
+void i2c1_protocol_init(void) {}
+void i2c1_protocol_send(uint8_t *data, uint32_t len) { sink(data, len); }
+uint8_t i2c1_protocol_receive(uint8_t *buffer, uint32_t len) { (void)buffer; (void)len; return 0u; }
+
+void usb_cdc_protocol_init(void) {}
+void usb_cdc_protocol_send(uint8_t *data, uint32_t len) { sink(data, len); }
+void usb_cdc_protocol_sendv(const comm_iovec_t *iov, uint8_t count)
+{
+    for (uint8_t i = 0u; i < count; i++) sink(iov[i].base, iov[i].len);
+}
+uint8_t usb_cdc_protocol_receive(uint8_t *buffer, uint32_t len) { (void)buffer; (void)len; return 0u; }
+uint8_t usb_cdc_protocol_data_available(void) { return 0u; }
+
+/* ------------------------------------------------------------------ */
+/*  Paths                                                             */
+/* ------------------------------------------------------------------ */
+
+static uint8_t s_header[FRAME_HEADER];
+static uint8_t s_payload[PAYLOAD_MAX];
+static uint8_t s_trailer[FRAME_TRAILER];
+static uint8_t s_scratch[FRAME_HEADER + PAYLOAD_MAX + FRAME_TRAILER];
+
+static void send_vectored(uint8_t comm_id, uint32_t len)
+{
+    const comm_iovec_t iov[3] = {
+        { s_header,  FRAME_HEADER  },
+        { s_payload, len           },
+        { s_trailer, FRAME_TRAILER },
+    };
+    comm_sendv(comm_id, iov, 3u);
+}
+
+static void send_sendv(uint32_t len)    { send_vectored(0u, len); }
+static void send_fallback(uint32_t len) { send_vectored(1u, len); }
+
+static void send_flatten(uint32_t len)
+{
+    memcpy(s_scratch, s_header, FRAME_HEADER);
+    memcpy(&s_scratch[FRAME_HEADER], s_payload, len);
+    memcpy(&s_scratch[FRAME_HEADER + len], s_trailer, FRAME_TRAILER);
+    comm_send(0u, s_scratch, FRAME_HEADER + len + FRAME_TRAILER);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double run(void (*path)(uint32_t), uint32_t len, uint32_t frames)
+{
+    for (uint32_t i = 0u; i < frames / 10u; i++) path(len);     /* warm up */
+
+    s_bytes = 0u;
+    double t0 = now_ns();
+    for (uint32_t i = 0u; i < frames; i++) path(len);
+    double t1 = now_ns();
+
+    if (s_bytes != (uint64_t)frames * (FRAME_HEADER + len + FRAME_TRAILER))
+    {
+        fprintf(stderr, "byte count mismatch\n");
+        exit(1);
+    }
+    return (t1 - t0) / frames;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 200000u;
+    static const uint32_t sizes[] = { 8u, 32u, 64u, 128u, 256u };
+
+    for (uint32_t i = 0u; i < PAYLOAD_MAX; i++) s_payload[i] = (uint8_t)i;
+
+    printf("%8s %12s %12s %12s %10s\n", "payload", "sendv ns", "fallback ns", "flatten ns", "frame B");
+    for (uint32_t s = 0u; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        uint32_t len = sizes[s];
+        double v = run(send_sendv, len, frames);
+        double f = run(send_fallback, len, frames);
+        double c = run(send_flatten, len, frames);
+        printf("%8u %12.1f %12.1f %12.1f %10u\n", len, v, f, c, FRAME_HEADER + len + FRAME_TRAILER);
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file usb_sim.c
+ * @brief Enumerate and exercise the USB CDC-ACM device on the host
+ *
+ *   usb_sim [bench_kb]
+ *
+ * Plays the USB host against usb_cdc.c through the endpoint FIFO model
+ * in usb_hw_host.c. The tool enumerates the device, opens the port
+ * (line coding, DTR) and echoes a pattern through both bulk endpoints,
+ * checking ping-pong flow control on the way, then halts and clears the
+ * bulk IN endpoint and lets a send time out. It ends with a bulk IN
+ * throughput run. Time is bus time at full speed, so KB/s is the ceiling
+ * the device core allows, not what a given PC achieves.
+ *
+ * Exits non-zero on the first failed check.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK_VERBOSE
+#include "test_check.h"
+#include "interface_usb.h"
+#include "interface_timebase_us.h"
+
+#define EP_OUT      1u
+#define EP_IN       1u
+
+
+/* ------------------------------------------------------------------ */
+/*  Control transfers                                                 */
+/* ------------------------------------------------------------------ */
+
+static void setup_pkt(uint8_t *s, uint8_t type, uint8_t req, uint16_t value, uint16_t index, uint16_t len)
+{
+    s[0] = type;           s[1] = req;
+    s[2] = value & 0xFFu;  s[3] = value >> 8;
+    s[4] = index & 0xFFu;  s[5] = index >> 8;
+    s[6] = len & 0xFFu;    s[7] = len >> 8;
+}
+
+/* Control read: returns bytes received, or -1 on STALL */
+static int control_in(uint8_t type, uint8_t req, uint16_t value, uint16_t index, uint8_t *buf, uint16_t len)
+{
+    uint8_t s[8];
+    setup_pkt(s, type, req, value, index, len);
+    if (usb_sim_setup(s) != 0) return -1;
+
+    int got = 0;
+    for (;;)
+    {
+        int n = usb_sim_in(0u, buf + got, (uint16_t)(len - got));
+        if (n < 0) return -1;
+        got += n;
+        if (n < 64 || got == len) break;
+    }
+    (void)usb_sim_out(0u, NULL, 0u);                    /* status stage */
+    return got;
+}
+
+/* Control write / no-data: returns 0, or -1 on STALL */
+static int control_out(uint8_t type, uint8_t req, uint16_t value, uint16_t index, const uint8_t *data, uint16_t len)
+{
+    uint8_t s[8];
+    setup_pkt(s, type, req, value, index, len);
+    if (usb_sim_setup(s) != 0) return -1;
+    if (len != 0u && usb_sim_out(0u, data, len) != len) return -1;
+
+    uint8_t zlp[1];
+    return (usb_sim_in(0u, zlp, sizeof(zlp)) == 0) ? 0 : -1;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Checks                                                            */
+/* ------------------------------------------------------------------ */
+
+static void test_enumerate(void)
+{
+    uint8_t buf[256];
+
+    usb_cdc_protocol_init();                            /* comm_init() at boot */
+    usb_sim_attach();
+    REQUIRE(usb_cdc_init_ok(), "controller init");
+
+    REQUIRE(control_in(0x80u, 0x06u, 0x0100u, 0u, buf, 64u) == 18 && buf[7] == 64u,
+          "device descriptor");
+    REQUIRE(control_out(0x00u, 0x05u, 12u, 0u, NULL, 0u) == 0 && usb_sim_address() == 12u,
+          "set address");
+
+    int n = control_in(0x80u, 0x06u, 0x0200u, 0u, buf, 9u);
+    uint16_t total = (uint16_t)(buf[2] | (buf[3] << 8));
+    REQUIRE(n == 9 && total == 67u, "config descriptor header");
+    REQUIRE(control_in(0x80u, 0x06u, 0x0200u, 0u, buf, 255u) == total, "config descriptor (two packets)");
+
+    n = control_in(0x80u, 0x06u, 0x0303u, 0x0409u, buf, 255u);
+    REQUIRE(n == 2 + 2 * 8 && buf[2] == '0', "serial string");
+
+    REQUIRE(control_in(0x80u, 0x06u, 0x0600u, 0u, buf, 10u) < 0, "device qualifier stalls");
+    REQUIRE(control_out(0x00u, 0x09u, 1u, 0u, NULL, 0u) == 0 && usb_cdc_configured(), "set configuration");
+    REQUIRE(control_in(0x80u, 0x08u, 0u, 0u, buf, 1u) == 1 && buf[0] == 1u, "get configuration");
+}
+
+static void test_open_port(void)
+{
+    const uint8_t coding[7] = { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 };     /* 115200 8N1 */
+    usb_cdc_line_coding_t lc;
+    uint8_t buf[8];
+
+    REQUIRE(control_out(0x21u, 0x20u, 0u, 0u, coding, 7u) == 0, "set line coding");
+    usb_cdc_line_coding(&lc);
+    REQUIRE(lc.baud == 115200u && lc.data_bits == 8u, "line coding stored");
+    REQUIRE(control_in(0xA1u, 0x21u, 0u, 0u, buf, 7u) == 7 && memcmp(buf, coding, 7u) == 0,
+          "get line coding");
+
+    uint8_t drop[] = "lost";
+    usb_cdc_protocol_send(drop, 4u);
+    REQUIRE(usb_sim_in(EP_IN, buf, sizeof(buf)) == USB_SIM_NAK, "no data before DTR");
+
+    REQUIRE(control_out(0x21u, 0x22u, 0x0001u, 0u, NULL, 0u) == 0 && usb_cdc_dtr(), "DTR set");
+}
+
+static void test_loopback(void)
+{
+    uint8_t pkt[64], back[256];
+
+    for (uint8_t i = 0u; i < sizeof(pkt); i++) pkt[i] = (uint8_t)(i * 7u + 1u);
+
+    /* two packets fill both RX buffers, the third is NAKed */
+    REQUIRE(usb_sim_out(EP_OUT, pkt, 64u) == 64, "OUT packet 1");
+    REQUIRE(usb_sim_out(EP_OUT, pkt, 64u) == 64, "OUT packet 2");
+    REQUIRE(usb_sim_out(EP_OUT, pkt, 64u) == USB_SIM_NAK, "OUT packet 3 NAKed");
+    REQUIRE(usb_cdc_protocol_data_available(), "data available");
+
+    uint8_t got = usb_cdc_protocol_receive(back, 100u);
+    REQUIRE(got == 100u && memcmp(back, pkt, 64u) == 0 && memcmp(back + 64, pkt, 36u) == 0,
+          "receive spans buffers");
+    REQUIRE(usb_sim_out(EP_OUT, pkt, 10u) == 10, "OUT resumes after drain");
+
+    got = usb_cdc_protocol_receive(back, 255u);
+    REQUIRE(got == 28u + 10u, "receive rest");
+
+    /* echo: 100 bytes = one full packet now, the remainder coalesced into the next */
+    usb_cdc_protocol_send(pkt, 64u);
+    usb_cdc_protocol_send(pkt, 36u);
+    int a = usb_sim_in(EP_IN, back, 64u);
+    int b = usb_sim_in(EP_IN, back + 64, 64u);
+    REQUIRE(a == 64 && b == 36 && memcmp(back, pkt, 64u) == 0, "IN ping-pong");
+    REQUIRE(usb_sim_in(EP_IN, back, 64u) == USB_SIM_NAK, "IN idle");
+
+    usb_cdc_protocol_send(pkt, 64u);
+    a = usb_sim_in(EP_IN, back, 64u);
+    b = usb_sim_in(EP_IN, back, 64u);
+    REQUIRE(a == 64 && b == 0, "ZLP after full packet");
+
+    /* telemetry-shaped frame: all three segments land in one packet */
+    const uint8_t hdr[6] = { 0xA5, 1, 2, 3, 4, 5 }, crc[2] = { 0x34, 0x12 };
+    const comm_iovec_t iov[3] = { { hdr, 6u }, { pkt, 20u }, { crc, 2u } };
+    usb_cdc_protocol_sendv(iov, 3u);
+    a = usb_sim_in(EP_IN, back, 64u);
+    REQUIRE(a == 28 && memcmp(back, hdr, 6u) == 0 && memcmp(back + 6, pkt, 20u) == 0 &&
+          memcmp(back + 26, crc, 2u) == 0, "sendv packs segments into one packet");
+}
+
+static void test_halt(void)
+{
+    uint8_t pkt[8] = { 1, 2, 3, 4, 5, 6, 7, 8 }, back[64];
+
+    REQUIRE(control_out(0x02u, 0x03u, 0u, 0x80u | EP_IN, NULL, 0u) == 0, "set halt on bulk IN");
+    usb_cdc_protocol_send(pkt, sizeof(pkt));
+    REQUIRE(usb_sim_in(EP_IN, back, sizeof(back)) == USB_SIM_STALL, "halted IN stalls");
+    REQUIRE(control_out(0x02u, 0x01u, 0u, 0x80u | EP_IN, NULL, 0u) == 0, "clear halt on bulk IN");
+    REQUIRE(usb_sim_in(EP_IN, back, sizeof(back)) == 8 && memcmp(back, pkt, 8u) == 0,
+          "IN resumes after clear halt");
+    REQUIRE(control_out(0x02u, 0x01u, 0u, 0x85u, NULL, 0u) < 0, "clear halt on unknown endpoint stalls");
+}
+
+static void test_timeout(void)
+{
+    usb_cdc_stats_t before, after;
+    uint8_t data[200] = {0};
+
+    usb_cdc_stats(&before);
+    usb_cdc_protocol_send(data, sizeof(data));            /* nobody reads EP1 IN */
+    usb_cdc_stats(&after);
+    REQUIRE(after.tx_dropped > before.tx_dropped, "send times out when the host stops reading");
+
+    uint64_t t0 = timebase_us_get();
+    usb_cdc_protocol_send(data, 32u);
+    REQUIRE(timebase_us_get() - t0 < USB_CDC_TX_TIMEOUT_US, "later sends drop without waiting again");
+
+    uint8_t buf[64];
+    while (usb_sim_in(EP_IN, buf, sizeof(buf)) >= 0) {}
+}
+
+/* ------------------------------------------------------------------ */
+/*  Throughput                                                        */
+/* ------------------------------------------------------------------ */
+
+static uint32_t s_sink_bytes;
+
+static void sink(const uint8_t *data, uint16_t len)
+{
+    (void)data;
+    s_sink_bytes += len;
+}
+
+static void bench(uint32_t kb)
+{
+    uint8_t chunk[48];
+    memset(chunk, 'x', sizeof(chunk));
+
+    usb_sim_set_in_sink(EP_IN, sink);
+    s_sink_bytes = 0u;
+
+    uint32_t total = kb * 1024u;
+    uint64_t t0    = timebase_us_get();
+    for (uint32_t sent = 0u; sent < total; sent += sizeof(chunk))
+    {
+        usb_cdc_protocol_send(chunk, sizeof(chunk));
+    }
+    uint64_t t1 = timebase_us_get();
+
+    uint8_t buf[64];
+    int n;
+    while ((n = usb_sim_in(EP_IN, buf, sizeof(buf))) >= 0) s_sink_bytes += (uint32_t)n;
+    usb_sim_set_in_sink(EP_IN, NULL);
+
+    uint64_t us = t1 - t0;
+    printf("bench %u KB in %llu us bus time -> %llu KB/s (sink %u bytes)\n",
+           (unsigned)kb, (unsigned long long)us,
+           (unsigned long long)(us ? (uint64_t)kb * 1000000u / us : 0u),
+           (unsigned)s_sink_bytes);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t kb = (argc > 1) ? (uint32_t)atoi(argv[1]) : 64u;
+
+    timebase_us_host_set(0u);
+
+    test_enumerate();
+    if (!check_failed()) test_open_port();
+    if (!check_failed()) test_loopback();
+    if (!check_failed()) test_halt();
+    if (!check_failed()) test_timeout();
+    if (!check_failed()) bench(kb);
+
+    return check_summary("usb_sim");
+}